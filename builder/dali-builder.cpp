@@ -24,23 +24,44 @@
 //
 //       and edit layout.json in a text editor saving to trigger the reload
 //
+//  - DALI_BUILDER_PROFILE=1 prints how long each update took, by phase, and
+//    which nodes, types, templates and styles are the slowest to create;
+//    DALI_BUILDER_TRACE=trace.json also writes a Chrome trace of it
+//
 //------------------------------------------------------------------------------
 
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali-toolkit/devel-api/builder/builder.h>
 #include <dali-toolkit/devel-api/builder/tree-node.h>
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
 #include <map>
+#include <sstream>
 #include <string>
 #include <fstream>
 #include <streambuf>
 
-#include "sys/stat.h"
+#include <set>
+#include <vector>
+#include <cerrno>
+#include <cstdlib>
 #include <ctime>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+#include <dali/devel-api/adaptor-framework/event-thread-callback.h>
+#include <dali-toolkit/devel-api/builder/json-parser.h>
 
 #include <dali/integration-api/debug.h>
 
+#include "shared/compiled-layout.h"
+
 #define TOKEN_STRING(x) #x
 
 using namespace Dali;
@@ -49,6 +70,15 @@ using namespace Dali::Toolkit;
 namespace
 {
 
+const int DEBOUNCE_TIME = 50;    // ms without changes before reloading
+const int POLL_INTERVAL = 500;   // ms between checks when the files cannot be watched
+
+const char* const PATCH_NAME = "dali-builder-patch"; // The style and template used to patch the scene
+
+const char* const PROFILE_ENV = "DALI_BUILDER_PROFILE"; // Set to print where the time goes when the scene is built
+const char* const TRACE_ENV = "DALI_BUILDER_TRACE";     // Set to a file to also write a Chrome trace (chrome://tracing)
+const unsigned int HOT_LIST_SIZE = 20;                  // The number of nodes and types reported
+
 std::string JSON_BROKEN("                                      \
 {                                                              \
   'stage':                                                     \
@@ -73,12 +103,241 @@ std::string ReplaceQuotes(const std::string &single_quoted)
   return s;
 }
 
+/**
+ * Replaces the {CONSTANT}s in a string with their values, as the builder does.
+ */
+std::string ExpandConstants(const std::string &text, const Property::Map &constants)
+{
+  std::string expanded(text);
+  size_t start = 0;
+  while((start = expanded.find('{', start)) != std::string::npos)
+  {
+    const size_t end = expanded.find('}', start);
+    if(end == std::string::npos)
+    {
+      break;
+    }
+
+    std::string value;
+    const Property::Value* constant = constants.Find(expanded.substr(start + 1, end - start - 1));
+    if(constant && constant->Get(value))
+    {
+      expanded.replace(start, end - start + 1, value);
+      start += value.size();
+    }
+    else
+    {
+      start = end + 1;
+    }
+  }
+
+  return expanded;
+}
+
+/**
+ * Collects the files a JSON node refers to: every string that names an existing file,
+ * relative to the working directory or to the JSON file's directory.
+ */
+void CollectFiles(const TreeNode &node, const Property::Map &constants, const std::string &directory, std::set<std::string> &files)
+{
+  if(node.GetType() == TreeNode::STRING)
+  {
+    const std::string path = ExpandConstants(node.GetString(), constants);
+    if(path.find_first_of("./") != std::string::npos)
+    {
+      const std::string candidates[] = { path, directory + "/" + path };
+      for(unsigned int i = 0; i < ( path[0] == '/' ? 1u : 2u ); ++i)
+      {
+        struct stat buf;
+        if(0 == stat(candidates[i].c_str(), &buf) && S_ISREG(buf.st_mode))
+        {
+          files.insert(candidates[i]);
+          break;
+        }
+      }
+    }
+  }
+
+  for(TreeNode::ConstIterator iter = node.CBegin(); iter != node.CEnd(); ++iter)
+  {
+    CollectFiles((*iter).second, constants, directory, files);
+  }
+}
+
+/**
+ * Writes a string as a JSON string.
+ */
+void Quote(const char *text, std::ostream &stream)
+{
+  stream << '"';
+  for(const char* c = text; *c; ++c)
+  {
+    switch(*c)
+    {
+      case '"':  stream << "\\\""; break;
+      case '\\': stream << "\\\\"; break;
+      case '\n': stream << "\\n"; break;
+      case '\t': stream << "\\t"; break;
+      case '\r': stream << "\\r"; break;
+      default:   stream << *c; break;
+    }
+  }
+  stream << '"';
+}
+
+std::string Quote(const std::string &text)
+{
+  std::ostringstream stream;
+  Quote(text.c_str(), stream);
+  return stream.str();
+}
+
+/**
+ * Writes a JSON node back as JSON text.
+ */
+void Serialize(const TreeNode &node, std::ostream &stream)
+{
+  switch(node.GetType())
+  {
+    case TreeNode::OBJECT:
+    case TreeNode::ARRAY:
+    {
+      const bool isObject = node.GetType() == TreeNode::OBJECT;
+      stream << (isObject ? '{' : '[');
+      for(TreeNode::ConstIterator iter = node.CBegin(); iter != node.CEnd(); ++iter)
+      {
+        if(iter != node.CBegin())
+        {
+          stream << ',';
+        }
+        if(isObject)
+        {
+          Quote((*iter).first, stream);
+          stream << ':';
+        }
+        Serialize((*iter).second, stream);
+      }
+      stream << (isObject ? '}' : ']');
+      break;
+    }
+    case TreeNode::STRING:
+    {
+      Quote(node.GetString(), stream);
+      break;
+    }
+    case TreeNode::INTEGER:
+    {
+      stream << node.GetInteger();
+      break;
+    }
+    case TreeNode::FLOAT:
+    {
+      std::ostringstream number;
+      number.precision(9);
+      number << node.GetFloat();
+      stream << number.str();
+      break;
+    }
+    case TreeNode::BOOLEAN:
+    {
+      stream << (node.GetBoolean() ? "true" : "false");
+      break;
+    }
+    case TreeNode::IS_NULL:
+    {
+      stream << "null";
+      break;
+    }
+  }
+}
+
+std::string Serialize(const TreeNode *node)
+{
+  std::ostringstream stream;
+  if(node)
+  {
+    Serialize(*node, stream);
+  }
+  return stream.str();
+}
+
+/**
+ * Writes a JSON object without one of its members.
+ */
+std::string SerializeWithout(const TreeNode &object, const std::string &key)
+{
+  std::ostringstream stream;
+  stream << '{';
+  for(TreeNode::ConstIterator iter = object.CBegin(); iter != object.CEnd(); ++iter)
+  {
+    if(key != (*iter).first)
+    {
+      if(stream.tellp() > 1)
+      {
+        stream << ',';
+      }
+      Quote((*iter).first, stream);
+      stream << ':';
+      Serialize((*iter).second, stream);
+    }
+  }
+  stream << '}';
+  return stream.str();
+}
+
+/**
+ * A JSON object member, "name":value.
+ */
+std::string Member(const std::string &name, const std::string &value)
+{
+  return Quote(name) + ":" + value;
+}
+
+/**
+ * Whether two JSON nodes are the same.
+ */
+bool Equal(const TreeNode *lhs, const TreeNode *rhs)
+{
+  return Serialize(lhs) == Serialize(rhs);
+}
+
+/**
+ * The name of an actor's node, empty if it has none.
+ */
+std::string GetActorName(const TreeNode &node)
+{
+  const TreeNode* name = node.GetChild("name");
+  return name && name->GetType() == TreeNode::STRING ? name->GetString() : std::string();
+}
+
+/**
+ * Finds the direct child of an actor with a name.
+ */
+Actor FindDirectChild(Actor parent, const std::string &name)
+{
+  for(unsigned int i = 0; i < parent.GetChildCount(); ++i)
+  {
+    Actor child = parent.GetChildAt(i);
+    if(child.GetName() == name)
+    {
+      return child;
+    }
+  }
+  return Actor();
+}
+
 } // anon namespace
 
 
 //------------------------------------------------------------------------------
 //
+// Watches the JSON file and the files it refers to.
 //
+// On Linux, inotify watches the directories of the files (editors often save by
+// replacing the file, which would end a watch on the file itself) from a thread
+// that wakes the event thread once the changes have settled for a short time.
+// Elsewhere, or if inotify is unavailable, the files are polled on a timer.
+// Either way a change is confirmed by the file's nanosecond mtime, size or inode.
 //
 //------------------------------------------------------------------------------
 class FileWatcher
@@ -86,73 +345,598 @@ class FileWatcher
 public:
   FileWatcher(void);
   ~FileWatcher(void);
-  explicit FileWatcher(const std::string &fn): mLastTime(0) { SetFilename(fn) ; };
 
   void SetFilename(const std::string &fn);
   std::string GetFilename();
 
+  /**
+   * Sets the other files to watch, e.g. the images and scripts the JSON refers to.
+   */
+  void SetDependencies(const std::vector<std::string> &files);
+
+  /**
+   * Starts watching for changes, calling changedCallback on the event thread after
+   * the files have changed. Takes ownership of the callback.
+   *
+   * @return false if changes cannot be notified, in which case FileHasChanged() must be polled.
+   */
+  bool Start(CallbackBase* changedCallback);
+
+  /**
+   * Whether any of the watched files has changed since the last call.
+   */
   bool FileHasChanged(void);
   std::string GetFileContents(void) { return GetFileContents(mstringPath) ; };
 
 private:
-  // compiler does
-  // FileWatcher(const FileWatcher&);
-  // FileWatcher &operator=(const FileWatcher &);
+  FileWatcher(const FileWatcher&);
+  FileWatcher &operator=(const FileWatcher &);
+
+  /**
+   * What identifies a version of a file.
+   */
+  struct FileState
+  {
+    bool operator!=(const FileState &rhs) const
+    {
+      return exists != rhs.exists || seconds != rhs.seconds || nanoseconds != rhs.nanoseconds || size != rhs.size || inode != rhs.inode;
+    }
+
+    bool   exists;
+    time_t seconds;
+    long   nanoseconds;
+    off_t  size;
+    ino_t  inode;
+  };
+
+  typedef std::map<std::string, FileState> FileStates;
+
+  static FileState GetFileState(const std::string &fn);
+
+  void UpdateWatches();
+
+#ifdef __linux__
+  static void* WatchThread(void* data);
+  void Watch();
+#endif
+
+  std::string mstringPath;
+  std::vector<std::string> mDependencies;
+  FileStates mFileStates;                    ///< The files being watched, with their state when last checked
+
+#ifdef __linux__
+  typedef std::map<int, std::set<std::string> > WatchedNames;
+
+  int mInotify;                              ///< -1 if not watching
+  int mWakePipe[2];                          ///< Written to stop the watch thread
+  pthread_t mThread;
+  pthread_mutex_t mMutex;                    ///< Guards mWatchedNames
+  std::map<std::string, int> mWatchedDirectories;
+  WatchedNames mWatchedNames;                ///< The names of the files watched in each watched directory
+  EventThreadCallback* mChangedTrigger;
+#endif
+
+  std::string GetFileContents(const std::string &fn)
+  {
+    // The compiled layout, if it is installed and up to date
+    return DemoHelper::ReadLayout(fn);
+  };
+};
+
+FileWatcher::FileWatcher(void)
+#ifdef __linux__
+: mInotify(-1),
+  mThread(),
+  mChangedTrigger(NULL)
+#endif
+{
+#ifdef __linux__
+  mWakePipe[0] = mWakePipe[1] = -1;
+  pthread_mutex_init(&mMutex, NULL);
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#ifdef __linux__
+  if(mInotify >= 0)
+  {
+    char stop = 0;
+    if(write(mWakePipe[1], &stop, 1) == 1)
+    {
+      pthread_join(mThread, NULL);
+    }
+    close(mWakePipe[0]);
+    close(mWakePipe[1]);
+    close(mInotify);
+  }
+  delete mChangedTrigger;
+  pthread_mutex_destroy(&mMutex);
+#endif
+}
+
+void FileWatcher::SetFilename(const std::string &fn)
+{
+  mstringPath = fn;
+  UpdateWatches();
+}
+
+std::string FileWatcher::GetFilename(void)
+{
+  return mstringPath;
+}
+
+void FileWatcher::SetDependencies(const std::vector<std::string> &files)
+{
+  mDependencies = files;
+  UpdateWatches();
+}
+
+FileWatcher::FileState FileWatcher::GetFileState(const std::string &fn)
+{
+  FileState state = FileState();
+
+  struct stat buf;
+  if(0 == stat(fn.c_str(), &buf))
+  {
+    state.exists = true;
+    state.seconds = buf.st_mtim.tv_sec;
+    state.nanoseconds = buf.st_mtim.tv_nsec;
+    state.size = buf.st_size;
+    state.inode = buf.st_ino;
+  }
+
+  return state;
+}
+
+bool FileWatcher::FileHasChanged(void)
+{
+  bool changed = false;
+
+  for(FileStates::iterator iter = mFileStates.begin(); iter != mFileStates.end(); ++iter)
+  {
+    FileState state = GetFileState(iter->first);
+    if(state != iter->second)
+    {
+      changed = true;
+      iter->second = state;
+    }
+  }
+
+  if(!mFileStates[mstringPath].exists)
+  {
+    DALI_LOG_WARNING("File does not exist '%s'\n", mstringPath.c_str());
+    return false;
+  }
+
+  return changed;
+}
+
+void FileWatcher::UpdateWatches()
+{
+  // Keep the states of the files still watched, so a change is not missed
+  FileStates states;
+  states[mstringPath] = FileState();
+  for(std::vector<std::string>::const_iterator iter = mDependencies.begin(); iter != mDependencies.end(); ++iter)
+  {
+    states[*iter] = FileState();
+  }
+  for(FileStates::iterator iter = states.begin(); iter != states.end(); ++iter)
+  {
+    FileStates::const_iterator previous = mFileStates.find(iter->first);
+    iter->second = previous != mFileStates.end() ? previous->second : GetFileState(iter->first);
+  }
+  mFileStates.swap(states);
+
+#ifdef __linux__
+  if(mInotify < 0)
+  {
+    return;
+  }
+
+  WatchedNames watchedNames;
+  for(FileStates::const_iterator iter = mFileStates.begin(); iter != mFileStates.end(); ++iter)
+  {
+    const std::string &path = iter->first;
+    const size_t slash = path.rfind('/');
+    const std::string directory = slash == std::string::npos ? "." : ( slash == 0 ? "/" : path.substr(0, slash) );
+    const std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+
+    std::map<std::string, int>::iterator watch = mWatchedDirectories.find(directory);
+    if(watch == mWatchedDirectories.end())
+    {
+      const int wd = inotify_add_watch(mInotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_ATTRIB);
+      if(wd < 0)
+      {
+        DALI_LOG_WARNING("Cannot watch '%s'\n", directory.c_str());
+        continue;
+      }
+      watch = mWatchedDirectories.insert(std::make_pair(directory, wd)).first;
+    }
+    watchedNames[watch->second].insert(name);
+  }
+
+  pthread_mutex_lock(&mMutex);
+  mWatchedNames.swap(watchedNames);
+  pthread_mutex_unlock(&mMutex);
+#endif
+}
+
+bool FileWatcher::Start(CallbackBase* changedCallback)
+{
+#ifdef __linux__
+  mChangedTrigger = new EventThreadCallback(changedCallback);
+
+  mInotify = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+  if(mInotify < 0)
+  {
+    return false;
+  }
+
+  if(pipe(mWakePipe) != 0)
+  {
+    close(mInotify);
+    mInotify = -1;
+    return false;
+  }
+
+  UpdateWatches();
+
+  if(pthread_create(&mThread, NULL, &FileWatcher::WatchThread, this) != 0)
+  {
+    close(mWakePipe[0]);
+    close(mWakePipe[1]);
+    close(mInotify);
+    mInotify = -1;
+    return false;
+  }
+
+  return true;
+#else
+  delete changedCallback;
+  return false;
+#endif
+}
+
+#ifdef __linux__
+
+void* FileWatcher::WatchThread(void* data)
+{
+  static_cast<FileWatcher*>(data)->Watch();
+  return NULL;
+}
+
+void FileWatcher::Watch()
+{
+  pollfd fds[2];
+  fds[0].fd = mInotify;
+  fds[0].events = POLLIN;
+  fds[1].fd = mWakePipe[0];
+  fds[1].events = POLLIN;
+
+  // Events are read in full, so the buffer is aligned for them and can hold the longest name
+  char buffer[ 4096 ] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+
+  // Wait for a change, then for a quiet period, as saving can take several writes and renames
+  bool changed = false;
+  int timeout = -1;
+  for(;;)
+  {
+    if(poll(fds, 2, timeout) < 0)
+    {
+      if(errno == EINTR)
+      {
+        continue;
+      }
+      break;
+    }
+
+    if(fds[1].revents & POLLIN)
+    {
+      break;
+    }
+
+    if(!(fds[0].revents & POLLIN))
+    {
+      // Quiet for the debounce period
+      if(changed)
+      {
+        mChangedTrigger->Trigger();
+        changed = false;
+      }
+      timeout = -1;
+      continue;
+    }
+
+    ssize_t length;
+    while((length = read(mInotify, buffer, sizeof(buffer))) > 0)
+    {
+      pthread_mutex_lock(&mMutex);
+      for(char* ptr = buffer; ptr < buffer + length; )
+      {
+        const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(ptr);
+        WatchedNames::const_iterator names = mWatchedNames.find(event->wd);
+        if(event->len > 0 && names != mWatchedNames.end() && names->second.count(event->name))
+        {
+          changed = true;
+        }
+        ptr += sizeof(struct inotify_event) + event->len;
+      }
+      pthread_mutex_unlock(&mMutex);
+    }
+
+    if(changed)
+    {
+      timeout = DEBOUNCE_TIME;
+    }
+  }
+}
+
+#endif // __linux__
+
+
+//------------------------------------------------------------------------------
+//
+// Times where a scene update spends its time, by phase and by JSON node
+//
+//------------------------------------------------------------------------------
+class SceneProfiler
+{
+public:
+  SceneProfiler(void);
+
+  /**
+   * Whether profiling was asked for, by setting DALI_BUILDER_PROFILE or DALI_BUILDER_TRACE.
+   */
+  bool IsEnabled(void) const { return mEnabled; }
+
+  /**
+   * Starts profiling an update of the scene, forgetting the last one.
+   */
+  void Start(const std::string &filename);
+
+  /**
+   * Starts timing a phase of the update, ending the current phase.
+   */
+  void BeginPhase(const std::string &name);
+
+  void EndPhase(void);
+
+  /**
+   * Records how long a node of the stage took to create by itself, without its children.
+   */
+  void AddNode(const std::string &path, const std::string &type, const std::vector<std::string> &styles,
+               unsigned long long start, unsigned long long duration);
+
+  /**
+   * Prints the phases and the slowest nodes, types, templates and styles, and writes the trace.
+   */
+  void Report(void);
+
+  /**
+   * Monotonic time in microseconds.
+   */
+  static unsigned long long Now(void);
+
+private:
+  struct Event
+  {
+    std::string name;
+    std::string category;
+    unsigned long long start;
+    unsigned long long duration;
+    std::string type;                 ///< Of a node
+    std::vector<std::string> styles;  ///< Of a node
+  };
+
+  struct Cost
+  {
+    Cost(void) : duration(0), count(0) {}
+
+    bool operator<(const Cost &rhs) const { return duration > rhs.duration; }
+
+    std::string name;
+    unsigned long long duration;
+    unsigned int count;
+  };
+
+  typedef std::map<std::string, Cost> Costs;
+
+  static void AddCost(Costs &costs, const std::string &name, unsigned long long duration);
+  static void PrintCosts(const std::string &title, const Costs &costs);
+  void WriteTrace(const std::string &path);
+
+  bool mEnabled;
+  std::string mTracePath;
+  std::string mFilename;
+  unsigned long long mStart;
+  std::vector<Event> mPhases;
+  std::vector<Event> mNodes;
+  bool mInPhase;
+};
+
+SceneProfiler::SceneProfiler(void)
+: mEnabled(false),
+  mStart(0),
+  mInPhase(false)
+{
+  const char* profile = getenv(PROFILE_ENV);
+  const char* trace = getenv(TRACE_ENV);
+  mEnabled = (profile && *profile && std::string(profile) != "0") || (trace && *trace);
+  mTracePath = trace ? trace : "";
+}
+
+unsigned long long SceneProfiler::Now(void)
+{
+  timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return static_cast<unsigned long long>(time.tv_sec) * 1000000ull + time.tv_nsec / 1000;
+}
+
+void SceneProfiler::Start(const std::string &filename)
+{
+  mFilename = filename;
+  mStart = Now();
+  mPhases.clear();
+  mNodes.clear();
+  mInPhase = false;
+}
+
+void SceneProfiler::BeginPhase(const std::string &name)
+{
+  if(!mEnabled)
+  {
+    return;
+  }
+
+  EndPhase();
+
+  Event phase;
+  phase.name = name;
+  phase.category = "phase";
+  phase.start = Now();
+  phase.duration = 0;
+  mPhases.push_back(phase);
+  mInPhase = true;
+}
+
+void SceneProfiler::EndPhase(void)
+{
+  if(mInPhase)
+  {
+    mPhases.back().duration = Now() - mPhases.back().start;
+    mInPhase = false;
+  }
+}
+
+void SceneProfiler::AddNode(const std::string &path, const std::string &type, const std::vector<std::string> &styles,
+                            unsigned long long start, unsigned long long duration)
+{
+  Event node;
+  node.name = path;
+  node.category = "node";
+  node.start = start;
+  node.duration = duration;
+  node.type = type;
+  node.styles = styles;
+  mNodes.push_back(node);
+}
 
-  std::time_t mLastTime;
-  std::string mstringPath;
+void SceneProfiler::AddCost(Costs &costs, const std::string &name, unsigned long long duration)
+{
+  Cost &cost = costs[name];
+  cost.name = name;
+  cost.duration += duration;
+  ++cost.count;
+}
 
-  std::string GetFileContents(const std::string &fn)
+void SceneProfiler::PrintCosts(const std::string &title, const Costs &costs)
+{
+  std::vector<Cost> sorted;
+  for(Costs::const_iterator iter = costs.begin(); iter != costs.end(); ++iter)
   {
-    std::ifstream t(fn.c_str());
-    return std::string((std::istreambuf_iterator<char>(t)), std::istreambuf_iterator<char>());
-  };
-};
+    sorted.push_back(iter->second);
+  }
+  std::sort(sorted.begin(), sorted.end());
 
-FileWatcher::FileWatcher(void) : mLastTime(0)
-{
+  std::cout << "  " << title << ":" << std::endl;
+  for(size_t i = 0; i < sorted.size() && i < HOT_LIST_SIZE; ++i)
+  {
+    std::cout << "    " << std::setw(9) << sorted[i].duration / 1000.0 << " ms  " << std::setw(4) << sorted[i].count << " x  " << sorted[i].name << std::endl;
+  }
 }
 
-bool FileWatcher::FileHasChanged(void)
+void SceneProfiler::Report(void)
 {
-  struct stat buf;
+  EndPhase();
 
-  if(0 != stat(mstringPath.c_str(), &buf))
+  std::ios::fmtflags flags = std::cout.flags();
+  std::streamsize precision = std::cout.precision();
+  std::cout << std::fixed << std::setprecision(3);
+
+  std::cout << "dali-builder profile of " << mFilename << ":" << std::endl;
+  std::cout << "  phases:" << std::endl;
+  for(size_t i = 0; i < mPhases.size(); ++i)
   {
-    DALI_LOG_WARNING("File does not exist '%s'\n", mstringPath.c_str());
-    return false;
+    std::cout << "    " << std::setw(9) << mPhases[i].duration / 1000.0 << " ms  " << mPhases[i].name << std::endl;
   }
-  else
+  if(!mPhases.empty())
+  {
+    const Event &last = mPhases.back();
+    std::cout << "    " << std::setw(9) << (last.start + last.duration - mStart) / 1000.0 << " ms  total" << std::endl;
+  }
+
+  if(!mNodes.empty())
   {
-    if(buf.st_mtime > mLastTime)
+    // The nodes were created again, one by one, after the first frame so they do not delay it
+    Costs nodes;
+    Costs types;
+    Costs styles;
+    for(size_t i = 0; i < mNodes.size(); ++i)
     {
-      mLastTime = buf.st_mtime;
-      return true;
+      AddCost(nodes, mNodes[i].name + "  (" + mNodes[i].type + ")", mNodes[i].duration);
+      AddCost(types, mNodes[i].type, mNodes[i].duration);
+      for(size_t j = 0; j < mNodes[i].styles.size(); ++j)
+      {
+        AddCost(styles, mNodes[i].styles[j], mNodes[i].duration);
+      }
     }
-    else
+
+    PrintCosts("slowest nodes, each created without its children", nodes);
+    PrintCosts("slowest types and templates", types);
+    if(!styles.empty())
     {
-      mLastTime = buf.st_mtime;
-      return false;
+      PrintCosts("slowest styles, by the nodes using them", styles);
     }
   }
 
-  return false;
-}
+  std::cout.flags(flags);
+  std::cout.precision(precision);
 
-FileWatcher::~FileWatcher()
-{
+  if(!mTracePath.empty())
+  {
+    WriteTrace(mTracePath);
+  }
 }
 
-void FileWatcher::SetFilename(const std::string &fn)
+void SceneProfiler::WriteTrace(const std::string &path)
 {
-  mstringPath = fn;
-}
+  std::ofstream trace(path.c_str());
 
-std::string FileWatcher::GetFilename(void)
-{
-  return mstringPath;
-}
+  // The phases and the nodes are on separate rows, times are in microseconds
+  trace << "{\"traceEvents\":[";
+  for(size_t i = 0; i < mPhases.size() + mNodes.size(); ++i)
+  {
+    const bool isPhase = i < mPhases.size();
+    const Event &event = isPhase ? mPhases[i] : mNodes[i - mPhases.size()];
+    trace << (i ? ",\n" : "\n")
+          << "{\"name\":" << Quote(event.name)
+          << ",\"cat\":" << Quote(event.category)
+          << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << (isPhase ? 1 : 2)
+          << ",\"ts\":" << event.start - mStart
+          << ",\"dur\":" << event.duration;
+    if(!isPhase)
+    {
+      trace << ",\"args\":{\"type\":" << Quote(event.type) << ",\"styles\":[";
+      for(size_t j = 0; j < event.styles.size(); ++j)
+      {
+        trace << (j ? "," : "") << Quote(event.styles[j]);
+      }
+      trace << "]}";
+    }
+    trace << "}";
+  }
+  trace << "\n]}\n";
 
+  if(!trace)
+  {
+    std::cerr << "Unable to write the trace to " << path << std::endl;
+  }
+  else
+  {
+    std::cout << "Trace written to " << path << std::endl;
+  }
+}
 
 //------------------------------------------------------------------------------
 //
@@ -162,7 +946,7 @@ std::string FileWatcher::GetFilename(void)
 class ExampleApp : public ConnectionTracker
 {
 public:
-  ExampleApp(Application &app) : mApp(app)
+  ExampleApp(Application &app) : mApp(app), mProfileNodes(false)
   {
     app.InitSignal().Connect(this, &ExampleApp::Create);
 
@@ -175,9 +959,15 @@ public:
 
   void Create(Application& app)
   {
-    mTimer = Timer::New( 500 ); // ms
-    mTimer.TickSignal().Connect( this, &ExampleApp::OnTimer);
-    mTimer.Start();
+    UpdateJsonFile();
+
+    // Reload when the files change; poll them if they cannot be watched
+    if( !fw.Start( MakeCallback( this, &ExampleApp::OnFilesChanged ) ) )
+    {
+      mTimer = Timer::New( POLL_INTERVAL );
+      mTimer.TickSignal().Connect( this, &ExampleApp::OnTimer);
+      mTimer.Start();
+    }
 
     // Connect to key events in order to exit
     Stage::GetCurrent().KeyEventSignal().Connect(this, &ExampleApp::OnKeyEvent);
@@ -190,20 +980,446 @@ private:
   FileWatcher fw;
   Timer mTimer;
 
-  void ReloadJsonFile(Builder& builder, Layer& layer)
+  /**
+   * Updates the scene from the JSON file: patches the live actors if only the
+   * stage has changed, otherwise rebuilds everything.
+   */
+  void UpdateJsonFile()
+  {
+    mProfiler.Start( fw.GetFilename() );
+    mProfiler.BeginPhase( "read" );
+
+    std::string data(fw.GetFileContents());
+
+    mProfiler.BeginPhase( "parse for diffing" );
+
+    JsonParser document = JsonParser::New();
+    const bool parsed = document.Parse( data ) && document.GetRoot();
+
+    // The JSON is unchanged if a file it refers to has changed, which needs a rebuild
+    bool patched = parsed && mDocument && data != mDocumentText;
+    if( patched )
+    {
+      mProfiler.BeginPhase( "patch" );
+      patched = PatchStage( *mDocument.GetRoot(), *document.GetRoot() );
+    }
+    if( patched )
+    {
+      // Later lookups (e.g. the constants of the watched files) use the new document,
+      // but the actors that were kept may still refer to the old builder
+      mPatchBuilders.push_back( mBuilder );
+      mBuilder = CreatePatchBuilder( *document.GetRoot(), std::string(), std::string() );
+    }
+    if( !patched )
+    {
+      ReloadJsonFile( mBuilder, mRootLayer, data );
+    }
+
+    mDocument = parsed ? document : JsonParser();
+    mDocumentText = data;
+
+    mProfiler.BeginPhase( "watch files" );
+    WatchDependencies( mBuilder, mDocument );
+
+    if( mProfiler.IsEnabled() )
+    {
+      mProfileNodes = !patched && parsed;
+      WaitForFirstFrame();
+    }
+  }
+
+  /**
+   * Times the relayout and the rendering of the first frame, with a render task
+   * that renders an empty actor once; it finishes in the next frame rendered.
+   */
+  void WaitForFirstFrame()
   {
+    mProfiler.BeginPhase( "relayout and first frame" );
+
+    if( mProfileTask )
+    {
+      return;
+    }
+
     Stage stage = Stage::GetCurrent();
-    stage.SetBackgroundColor( Color::WHITE );
+    mProfileSource = Actor::New();
+    mProfileSource.SetSize( 1.0f, 1.0f );
+    stage.Add( mProfileSource );
 
-    builder = Builder::New();
+    mProfileTask = stage.GetRenderTaskList().CreateTask();
+    mProfileTask.SetSourceActor( mProfileSource );
+    mProfileTask.SetExclusive( true );
+    mProfileTask.SetInputEnabled( false );
+    mProfileTask.SetClearEnabled( false );
+    mProfileTask.SetTargetFrameBuffer( FrameBufferImage::New( 1u, 1u ) );
+    mProfileTask.SetRefreshRate( RenderTask::REFRESH_ONCE );
+    mProfileTask.FinishedSignal().Connect( this, &ExampleApp::OnFirstFrame );
+  }
+
+  void OnFirstFrame( RenderTask& renderTask )
+  {
+    mProfiler.EndPhase();
+
+    Stage::GetCurrent().GetRenderTaskList().RemoveTask( mProfileTask );
+    mProfileTask.Reset();
+    mProfileSource.Unparent();
+    mProfileSource.Reset();
+
+    if( mProfileNodes && mDocument )
+    {
+      ProfileNodes( *mDocument.GetRoot() );
+    }
+
+    mProfiler.Report();
+  }
+
+  /**
+   * Creates each node of the stage again by itself, without its children, to find
+   * which nodes, types, templates and styles are slow to create.
+   */
+  void ProfileNodes( const TreeNode& document )
+  {
+    const TreeNode* stage = document.GetChild( "stage" );
+    if( !stage )
+    {
+      return;
+    }
+
+    std::vector<const TreeNode*> nodes;
+    std::vector<std::string> paths;
+    CollectNodes( *stage, "stage", nodes, paths );
+
+    std::ostringstream templates;
+    for( size_t i = 0; i < nodes.size(); ++i )
+    {
+      templates << ( i ? "," : "" ) << Member( GetProfileName( i ), SerializeWithout( *nodes[i], "actors" ) );
+    }
+    Builder builder = CreatePatchBuilder( document, std::string(), templates.str() );
+
+    for( size_t i = 0; i < nodes.size(); ++i )
+    {
+      const TreeNode* type = nodes[i]->GetChild( "type" );
+      const TreeNode* styles = nodes[i]->GetChild( "styles" );
+
+      std::vector<std::string> styleNames;
+      if( styles && styles->GetType() == TreeNode::ARRAY )
+      {
+        for( TreeNode::ConstIterator iter = styles->CBegin(); iter != styles->CEnd(); ++iter )
+        {
+          if( (*iter).second.GetType() == TreeNode::STRING )
+          {
+            styleNames.push_back( (*iter).second.GetString() );
+          }
+        }
+      }
+
+      const unsigned long long start = SceneProfiler::Now();
+      BaseHandle handle = builder.Create( GetProfileName( i ) );
+      const unsigned long long duration = SceneProfiler::Now() - start;
+      handle.Reset();
+
+      mProfiler.AddNode( paths[i], type && type->GetType() == TreeNode::STRING ? type->GetString() : "?", styleNames, start, duration );
+    }
+  }
+
+  /**
+   * Collects the actor nodes below a node, with their paths in the document.
+   */
+  static void CollectNodes( const TreeNode& actors, const std::string& path, std::vector<const TreeNode*>& nodes, std::vector<std::string>& paths )
+  {
+    unsigned int index = 0;
+    for( TreeNode::ConstIterator iter = actors.CBegin(); iter != actors.CEnd(); ++iter, ++index )
+    {
+      const TreeNode& node = (*iter).second;
+      if( node.GetType() != TreeNode::OBJECT )
+      {
+        continue;
+      }
+
+      std::ostringstream nodePath;
+      nodePath << path << "/";
+      const std::string name = GetActorName( node );
+      if( name.empty() )
+      {
+        nodePath << index;
+      }
+      else
+      {
+        nodePath << name;
+      }
+
+      nodes.push_back( &node );
+      paths.push_back( nodePath.str() );
+
+      const TreeNode* children = node.GetChild( "actors" );
+      if( children )
+      {
+        CollectNodes( *children, nodePath.str(), nodes, paths );
+      }
+    }
+  }
+
+  static std::string GetProfileName( size_t index )
+  {
+    std::ostringstream name;
+    name << PATCH_NAME << "-" << index;
+    return name.str();
+  }
+
+  /**
+   * Applies the changes to the stage to the live actors, keeping the actors
+   * (and their resources) that have not changed.
+   *
+   * Actors are matched by name; a change to an actor without a name replaces
+   * its nearest named ancestor.
+   *
+   * @return false if the changes cannot be patched and the scene must be rebuilt.
+   */
+  bool PatchStage( const TreeNode& previous, const TreeNode& current )
+  {
+    // Everything but the stage must be the same, as it may affect every actor
+    std::set<std::string> sections;
+    for( TreeNode::ConstIterator iter = previous.CBegin(); iter != previous.CEnd(); ++iter )
+    {
+      sections.insert( (*iter).first );
+    }
+    for( TreeNode::ConstIterator iter = current.CBegin(); iter != current.CEnd(); ++iter )
+    {
+      sections.insert( (*iter).first );
+    }
+    for( std::set<std::string>::const_iterator iter = sections.begin(); iter != sections.end(); ++iter )
+    {
+      if( *iter != "stage" && !Equal( previous.GetChild( *iter ), current.GetChild( *iter ) ) )
+      {
+        return false;
+      }
+    }
+
+    return PatchChildren( mRootLayer, previous.GetChild( "stage" ), current.GetChild( "stage" ), current );
+  }
+
+  /**
+   * Patches the children of an actor.
+   *
+   * @return false if the children cannot be patched and the actor must be replaced.
+   */
+  bool PatchChildren( Actor parent, const TreeNode* previous, const TreeNode* current, const TreeNode& document )
+  {
+    if( Equal( previous, current ) )
+    {
+      return true;
+    }
+
+    // The children without a name cannot be told apart, so must all be the same
+    typedef std::map<std::string, const TreeNode*> NamedNodes;
+    NamedNodes previousNamed;
+    std::vector<const TreeNode*> currentNamed;
+    std::string previousUnnamed;
+    std::string currentUnnamed;
+
+    if( previous )
+    {
+      for( TreeNode::ConstIterator iter = previous->CBegin(); iter != previous->CEnd(); ++iter )
+      {
+        const std::string name = GetActorName( (*iter).second );
+        if( name.empty() )
+        {
+          previousUnnamed += Serialize( &(*iter).second );
+        }
+        else if( !previousNamed.insert( std::make_pair( name, &(*iter).second ) ).second )
+        {
+          return false;
+        }
+      }
+    }
+
+    std::set<std::string> currentNames;
+    if( current )
+    {
+      for( TreeNode::ConstIterator iter = current->CBegin(); iter != current->CEnd(); ++iter )
+      {
+        const std::string name = GetActorName( (*iter).second );
+        if( name.empty() )
+        {
+          currentUnnamed += Serialize( &(*iter).second );
+        }
+        else if( !currentNames.insert( name ).second )
+        {
+          return false;
+        }
+        else
+        {
+          currentNamed.push_back( &(*iter).second );
+        }
+      }
+    }
+
+    if( previousUnnamed != currentUnnamed )
+    {
+      return false;
+    }
+
+    // Check the live actors are there before changing anything
+    for( NamedNodes::const_iterator iter = previousNamed.begin(); iter != previousNamed.end(); ++iter )
+    {
+      if( !FindDirectChild( parent, iter->first ) )
+      {
+        return false;
+      }
+    }
+
+    for( NamedNodes::const_iterator iter = previousNamed.begin(); iter != previousNamed.end(); ++iter )
+    {
+      if( !currentNames.count( iter->first ) )
+      {
+        parent.Remove( FindDirectChild( parent, iter->first ) );
+      }
+    }
+
+    for( std::vector<const TreeNode*>::const_iterator iter = currentNamed.begin(); iter != currentNamed.end(); ++iter )
+    {
+      const TreeNode& node = **iter;
+      NamedNodes::const_iterator match = previousNamed.find( GetActorName( node ) );
+      if( match == previousNamed.end() )
+      {
+        CreateActor( parent, node, document );
+      }
+      else if( !Equal( match->second, &node ) )
+      {
+        Actor actor = FindDirectChild( parent, match->first );
+        if( !PatchActor( actor, *match->second, node, document ) )
+        {
+          parent.Remove( actor );
+          CreateActor( parent, node, document );
+        }
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Applies the changed properties of an actor, then patches its children.
+   *
+   * @return false if the actor must be replaced.
+   */
+  bool PatchActor( Actor actor, const TreeNode& previous, const TreeNode& current, const TreeNode& document )
+  {
+    // A property that is no longer set cannot be put back to its default
+    for( TreeNode::ConstIterator iter = previous.CBegin(); iter != previous.CEnd(); ++iter )
+    {
+      if( !current.GetChild( (*iter).first ) )
+      {
+        return false;
+      }
+    }
+
+    std::ostringstream changed;
+    for( TreeNode::ConstIterator iter = current.CBegin(); iter != current.CEnd(); ++iter )
+    {
+      const std::string key = (*iter).first;
+      const TreeNode* previousValue = previous.GetChild( key );
+      if( key == "actors" || Equal( previousValue, &(*iter).second ) )
+      {
+        continue;
+      }
+
+      // These are only used when the actor is created
+      if( !previousValue || key == "type" || key == "signals" || key == "styles" )
+      {
+        return false;
+      }
+
+      changed << ( changed.tellp() > 0 ? "," : "" ) << '"' << key << "\":" << Serialize( &(*iter).second );
+    }
+
+    if( changed.tellp() > 0 )
+    {
+      // Let the builder convert the properties by applying them as a style
+      Builder builder = CreatePatchBuilder( document, Member( PATCH_NAME, "{" + changed.str() + "}" ), std::string() );
+      Handle handle( actor );
+      builder.ApplyStyle( PATCH_NAME, handle );
+    }
+
+    return PatchChildren( actor, previous.GetChild( "actors" ), current.GetChild( "actors" ), document );
+  }
+
+  /**
+   * Creates an actor and its children from their JSON and adds it to a parent.
+   */
+  void CreateActor( Actor parent, const TreeNode& node, const TreeNode& document )
+  {
+    Builder builder = CreatePatchBuilder( document, std::string(), Member( PATCH_NAME, Serialize( &node ) ) );
+    Actor actor = Actor::DownCast( builder.Create( PATCH_NAME ) );
+    if( actor )
+    {
+      parent.Add( actor );
+    }
+  }
+
+  /**
+   * Creates a builder with everything in the document but the stage, so signal
+   * actions can find its animations and paths, plus more styles and templates
+   * given as JSON object members.
+   *
+   * The builder is kept until the next rebuild, as the actors it creates and
+   * styles may refer to it from their signals.
+   */
+  Builder CreatePatchBuilder( const TreeNode& document, const std::string& styles, const std::string& templates )
+  {
+    std::ostringstream json;
+    json << '{';
+    for( TreeNode::ConstIterator iter = document.CBegin(); iter != document.CEnd(); ++iter )
+    {
+      const std::string key = (*iter).first;
+      if( key != "stage" && key != "styles" && key != "templates" )
+      {
+        json << Member( key, Serialize( &(*iter).second ) ) << ',';
+      }
+    }
+    json << Member( "styles", AddMembers( document.GetChild( "styles" ), styles ) )
+         << ',' << Member( "templates", AddMembers( document.GetChild( "templates" ), templates ) )
+         << '}';
+
+    Builder builder = Builder::New();
     builder.QuitSignal().Connect( this, &ExampleApp::OnBuilderQuit );
+    builder.AddConstants( GetDefaultConstants() );
+    builder.LoadFromString( json.str() );
+    mPatchBuilders.push_back( builder );
+    return builder;
+  }
 
+  /**
+   * Serializes a JSON object with more members added.
+   */
+  static std::string AddMembers( const TreeNode* object, const std::string& members )
+  {
+    std::string json = object ? Serialize( object ) : "{}";
+    if( !members.empty() )
+    {
+      json.insert( json.size() - 1, ( json.size() > 2 ? "," : "" ) + members );
+    }
+    return json;
+  }
+
+  static Property::Map GetDefaultConstants()
+  {
     Property::Map defaultDirs;
     defaultDirs[ TOKEN_STRING(DEMO_IMAGE_DIR) ]  = DEMO_IMAGE_DIR;
     defaultDirs[ TOKEN_STRING(DEMO_MODEL_DIR) ]  = DEMO_MODEL_DIR;
     defaultDirs[ TOKEN_STRING(DEMO_SCRIPT_DIR) ] = DEMO_SCRIPT_DIR;
+    return defaultDirs;
+  }
+
+  void ReloadJsonFile(Builder& builder, Layer& layer, const std::string& data)
+  {
+    Stage stage = Stage::GetCurrent();
+    stage.SetBackgroundColor( Color::WHITE );
+
+    builder = Builder::New();
+    builder.QuitSignal().Connect( this, &ExampleApp::OnBuilderQuit );
 
-    builder.AddConstants( defaultDirs );
+    builder.AddConstants( GetDefaultConstants() );
 
     if(!layer)
     {
@@ -237,6 +1453,8 @@ private:
       }
     }
 
+    mProfiler.BeginPhase( "remove actors" );
+
     unsigned int numChildren = layer.GetChildCount();
 
     for(unsigned int i=0; i<numChildren; ++i)
@@ -244,7 +1462,9 @@ private:
       layer.Remove( layer.GetChildAt(0) );
     }
 
-    std::string data(fw.GetFileContents());
+    mPatchBuilders.clear();
+
+    mProfiler.BeginPhase( "load into builder" );
 
     try
     {
@@ -255,17 +1475,43 @@ private:
       builder.LoadFromString(ReplaceQuotes(JSON_BROKEN));
     }
 
-    builder.AddActors( layer );
+    // Includes resolving styles, and requesting images
+    mProfiler.BeginPhase( "create actors" );
 
+    builder.AddActors( layer );
   }
 
+  /**
+   * Watches the files the JSON refers to as well as the JSON file itself.
+   */
+  void WatchDependencies( Builder& builder, JsonParser& document )
+  {
+    std::set<std::string> files;
+
+    if( document )
+    {
+      const std::string filename = fw.GetFilename();
+      const size_t slash = filename.rfind( '/' );
+      const std::string directory = slash == std::string::npos ? "." : filename.substr( 0, slash );
 
-  bool OnTimer(void)
+      CollectFiles( *document.GetRoot(), builder.GetConstants(), directory, files );
+      files.erase( filename );
+    }
+
+    fw.SetDependencies( std::vector<std::string>( files.begin(), files.end() ) );
+  }
+
+  void OnFilesChanged()
   {
     if(fw.FileHasChanged())
     {
-      ReloadJsonFile( mBuilder, mRootLayer );
+      UpdateJsonFile();
     }
+  }
+
+  bool OnTimer(void)
+  {
+    OnFilesChanged();
 
     return true;
   }
@@ -288,6 +1534,14 @@ private:
   }
 
   Builder mBuilder;
+  std::vector<Builder> mPatchBuilders; ///< The builders used to patch the scene since it was last built
+  JsonParser mDocument;        ///< The JSON the scene was last built or patched from, empty if it did not parse
+  std::string mDocumentText;
+
+  SceneProfiler mProfiler;
+  Actor mProfileSource;        ///< Rendered to detect the first frame after an update
+  RenderTask mProfileTask;
+  bool mProfileNodes;          ///< Whether to profile the nodes after the first frame
 };
 
 //------------------------------------------------------------------------------
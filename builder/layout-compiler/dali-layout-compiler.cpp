@@ -0,0 +1,523 @@
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ * Compiles a Builder JSON layout (see resources/scripts) into compact JSON, which is installed
+ * next to the source in a "compiled" directory and read instead of it (see shared/compiled-layout.h).
+ *
+ * The JSON may have comments, which are dropped with the white space. "{NAME}" in a string is
+ * replaced by the value of a string constant from the layout's "constants" section or from a -D
+ * option, as Builder would do at run time. Constants that are not known are left for Builder.
+ * Strings and numbers are otherwise written as they were in the source, escapes included, so
+ * DALi's JsonParser reads them just as it reads the source.
+ *
+ * Usage: dali-layout-compiler [-D NAME=VALUE]... <layout.json> <compiled.json>
+ */
+
+// EXTERNAL INCLUDES
+#include <cerrno>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+typedef std::map<std::string, std::string> Constants; ///< The values are escaped, as in the JSON
+
+enum NodeType
+{
+  OBJECT,
+  ARRAY,
+  STRING,
+  NUMBER,
+  BOOLEAN,
+  NULL_VALUE
+};
+
+/**
+ * A node of the parsed JSON, in pre-order.
+ */
+struct ParsedNode
+{
+  NodeType    type;
+  std::string name;
+  bool        named;
+  std::string text;         ///< The source text of a number or boolean, or of a string between its quotes
+  size_t      descendants;
+};
+
+/**
+ * Parses JSON with comments into nodes, reporting the first error.
+ */
+class Parser
+{
+public:
+  Parser( const std::string& path, const std::string& text, std::vector<ParsedNode>& nodes )
+  : mPath( path ),
+    mText( text ),
+    mPosition( 0u ),
+    mNodes( nodes )
+  {
+  }
+
+  bool Parse()
+  {
+    if( !ParseValue( std::string(), false ) )
+    {
+      return false;
+    }
+
+    SkipSpace();
+    return mPosition == mText.size() || Error( "unexpected text after the end" );
+  }
+
+private:
+  bool Error( const std::string& message )
+  {
+    unsigned int line = 1u;
+    unsigned int column = 1u;
+    for( size_t i = 0; i < mPosition && i < mText.size(); ++i )
+    {
+      if( mText[i] == '\n' )
+      {
+        ++line;
+        column = 1u;
+      }
+      else
+      {
+        ++column;
+      }
+    }
+
+    std::cerr << mPath << ":" << line << ":" << column << ": " << message << std::endl;
+    return false;
+  }
+
+  char Peek() const
+  {
+    return mPosition < mText.size() ? mText[ mPosition ] : '\0';
+  }
+
+  void SkipSpace()
+  {
+    while( mPosition < mText.size() )
+    {
+      const char c = mText[ mPosition ];
+      if( c == ' ' || c == '\t' || c == '\r' || c == '\n' )
+      {
+        ++mPosition;
+      }
+      else if( mText.compare( mPosition, 2, "//" ) == 0 )
+      {
+        mPosition = mText.find( '\n', mPosition );
+      }
+      else if( mText.compare( mPosition, 2, "/*" ) == 0 )
+      {
+        const size_t end = mText.find( "*/", mPosition + 2 );
+        mPosition = end == std::string::npos ? mText.size() : end + 2;
+      }
+      else
+      {
+        break;
+      }
+    }
+
+    if( mPosition == std::string::npos )
+    {
+      mPosition = mText.size();
+    }
+  }
+
+  bool ParseValue( const std::string& name, bool named )
+  {
+    SkipSpace();
+
+    ParsedNode node;
+    node.type = NULL_VALUE;
+    node.name = name;
+    node.named = named;
+    node.descendants = 0u;
+
+    const size_t index = mNodes.size();
+    const char c = Peek();
+    if( c == '{' || c == '[' )
+    {
+      node.type = c == '{' ? OBJECT : ARRAY;
+      mNodes.push_back( node );
+      ++mPosition;
+      if( !ParseMembers( node.type == OBJECT ) )
+      {
+        return false;
+      }
+      mNodes[ index ].descendants = mNodes.size() - index - 1;
+      return true;
+    }
+
+    if( c == '"' )
+    {
+      node.type = STRING;
+      if( !ParseString( node.text ) )
+      {
+        return false;
+      }
+    }
+    else if( mText.compare( mPosition, 4, "true" ) == 0 || mText.compare( mPosition, 5, "false" ) == 0 )
+    {
+      node.type = BOOLEAN;
+      node.text = c == 't' ? "true" : "false";
+      mPosition += node.text.size();
+    }
+    else if( mText.compare( mPosition, 4, "null" ) == 0 )
+    {
+      mPosition += 4;
+    }
+    else if( !ParseNumber( node ) )
+    {
+      return false;
+    }
+
+    mNodes.push_back( node );
+    return true;
+  }
+
+  bool ParseMembers( bool object )
+  {
+    const char closer = object ? '}' : ']';
+    for( ;; )
+    {
+      SkipSpace();
+      if( Peek() == closer )
+      {
+        ++mPosition;
+        return true;
+      }
+
+      std::string name;
+      if( object )
+      {
+        if( Peek() != '"' )
+        {
+          return Error( "expected a member name" );
+        }
+        if( !ParseString( name ) )
+        {
+          return false;
+        }
+        SkipSpace();
+        if( Peek() != ':' )
+        {
+          return Error( "expected ':'" );
+        }
+        ++mPosition;
+      }
+
+      if( !ParseValue( name, object ) )
+      {
+        return false;
+      }
+
+      // A comma before the closer is tolerated
+      SkipSpace();
+      if( Peek() == ',' )
+      {
+        ++mPosition;
+      }
+      else if( Peek() != closer )
+      {
+        return Error( std::string( "expected ',' or '" ) + closer + "'" );
+      }
+    }
+  }
+
+  bool ParseString( std::string& text )
+  {
+    ++mPosition; // The opening quote
+    while( mPosition < mText.size() )
+    {
+      const char c = mText[ mPosition++ ];
+      if( c == '"' )
+      {
+        return true;
+      }
+
+      // An escape is kept as it is, with the character it escapes
+      text += c;
+      if( c == '\\' && mPosition < mText.size() )
+      {
+        text += mText[ mPosition++ ];
+      }
+    }
+
+    return Error( "unterminated string" );
+  }
+
+  bool ParseNumber( ParsedNode& node )
+  {
+    const size_t length = mText.find_first_not_of( "+-0123456789.eE", mPosition ) - mPosition;
+    const std::string number = mText.substr( mPosition, length );
+    if( number.empty() )
+    {
+      return Error( "expected a value" );
+    }
+
+    char* end = NULL;
+    errno = 0;
+    const double parsed = strtod( number.c_str(), &end );
+    if( *end != '\0' || errno != 0 || fabs( parsed ) > FLT_MAX )
+    {
+      return Error( "invalid number \"" + number + "\"" );
+    }
+    node.type = NUMBER;
+    node.text = number;
+    mPosition += length;
+    return true;
+  }
+
+private:
+  std::string              mPath;
+  const std::string&       mText;
+  size_t                   mPosition;
+  std::vector<ParsedNode>& mNodes;
+};
+
+/**
+ * Adds the string constants of the layout's "constants" section, which override the -D options.
+ */
+void AddLayoutConstants( const std::vector<ParsedNode>& nodes, Constants& constants )
+{
+  if( nodes.empty() || nodes[0].type != OBJECT )
+  {
+    return;
+  }
+
+  for( size_t i = 1; i < nodes.size(); i += nodes[i].descendants + 1 )
+  {
+    if( nodes[i].name == "constants" && nodes[i].type == OBJECT )
+    {
+      for( size_t j = i + 1; j <= i + nodes[i].descendants; j += nodes[j].descendants + 1 )
+      {
+        if( nodes[j].type == STRING )
+        {
+          constants[ nodes[j].name ] = nodes[j].text;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Replaces the known "{NAME}" constants in a string.
+ */
+std::string ExpandConstants( const std::string& text, const Constants& constants )
+{
+  std::string expanded( text );
+  size_t start = 0;
+  while( ( start = expanded.find( '{', start ) ) != std::string::npos )
+  {
+    const size_t end = expanded.find( '}', start );
+    if( end == std::string::npos )
+    {
+      break;
+    }
+
+    Constants::const_iterator constant = constants.find( expanded.substr( start + 1, end - start - 1 ) );
+    if( constant != constants.end() )
+    {
+      expanded.replace( start, end - start + 1, constant->second );
+      start += constant->second.size();
+    }
+    else
+    {
+      start = end + 1;
+    }
+  }
+
+  return expanded;
+}
+
+/**
+ * Escapes text to go between the quotes of a JSON string.
+ */
+std::string Escape( const std::string& text )
+{
+  std::string escaped;
+  for( std::string::const_iterator c = text.begin(); c != text.end(); ++c )
+  {
+    switch( *c )
+    {
+      case '"':  escaped += "\\\""; break;
+      case '\\': escaped += "\\\\"; break;
+      case '\n': escaped += "\\n"; break;
+      case '\r': escaped += "\\r"; break;
+      case '\t': escaped += "\\t"; break;
+      case '\b': escaped += "\\b"; break;
+      case '\f': escaped += "\\f"; break;
+      default:
+      {
+        if( static_cast<unsigned char>( *c ) < 0x20 )
+        {
+          char code[8];
+          snprintf( code, sizeof( code ), "\\u%04x", static_cast<unsigned int>( *c ) );
+          escaped += code;
+        }
+        else
+        {
+          escaped += *c;
+        }
+        break;
+      }
+    }
+  }
+  return escaped;
+}
+
+/**
+ * Writes the nodes as compact JSON, expanding the constants in their strings.
+ */
+void WriteJson( const std::vector<ParsedNode>& nodes, const Constants& constants, std::string& json )
+{
+  // The open objects and arrays, and where each ends
+  std::vector<size_t> ends;
+  std::vector<char> closers;
+  for( size_t i = 0; i < nodes.size(); ++i )
+  {
+    while( !ends.empty() && i == ends.back() )
+    {
+      json += closers.back();
+      ends.pop_back();
+      closers.pop_back();
+    }
+
+    const ParsedNode& node = nodes[i];
+    if( !ends.empty() && json[ json.size() - 1 ] != '{' && json[ json.size() - 1 ] != '[' )
+    {
+      json += ',';
+    }
+    if( node.named )
+    {
+      json += '"' + node.name + "\":";
+    }
+
+    switch( node.type )
+    {
+      case OBJECT:
+      case ARRAY:
+      {
+        json += node.type == OBJECT ? '{' : '[';
+        ends.push_back( i + 1 + node.descendants );
+        closers.push_back( node.type == OBJECT ? '}' : ']' );
+        break;
+      }
+      case STRING:
+      {
+        json += '"' + ExpandConstants( node.text, constants ) + '"';
+        break;
+      }
+      case NUMBER:
+      case BOOLEAN:
+      {
+        json += node.text;
+        break;
+      }
+      case NULL_VALUE:
+      {
+        json += "null";
+        break;
+      }
+    }
+  }
+
+  while( !closers.empty() )
+  {
+    json += closers.back();
+    closers.pop_back();
+  }
+}
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+  Constants constants;
+  int argument = 1;
+  for( ; argument + 1 < argc && strcmp( argv[ argument ], "-D" ) == 0; argument += 2 )
+  {
+    const std::string definition( argv[ argument + 1 ] );
+    const size_t equals = definition.find( '=' );
+    if( equals == std::string::npos || equals == 0 )
+    {
+      std::cerr << argv[0] << ": expected NAME=VALUE after -D, not \"" << definition << "\"" << std::endl;
+      return EXIT_FAILURE;
+    }
+    constants[ definition.substr( 0, equals ) ] = Escape( definition.substr( equals + 1 ) );
+  }
+
+  if( argc - argument != 2 )
+  {
+    std::cerr << "Usage: " << argv[0] << " [-D NAME=VALUE]... <layout.json> <compiled.json>" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char* inputPath = argv[ argument ];
+  const char* outputPath = argv[ argument + 1 ];
+
+  std::ifstream input( inputPath );
+  if( !input )
+  {
+    std::cerr << inputPath << ": cannot open" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string text( ( std::istreambuf_iterator<char>( input ) ), std::istreambuf_iterator<char>() );
+
+  std::vector<ParsedNode> parsedNodes;
+  Parser parser( inputPath, text, parsedNodes );
+  if( !parser.Parse() )
+  {
+    return EXIT_FAILURE;
+  }
+
+  AddLayoutConstants( parsedNodes, constants );
+
+  std::string json;
+  WriteJson( parsedNodes, constants, json );
+  json += '\n';
+
+  FILE* output = fopen( outputPath, "wb" );
+  if( !output )
+  {
+    std::cerr << outputPath << ": cannot create" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const bool written = fwrite( json.c_str(), 1, json.size(), output ) == json.size();
+  if( fclose( output ) != 0 || !written )
+  {
+    std::cerr << outputPath << ": cannot write" << std::endl;
+    remove( outputPath );
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
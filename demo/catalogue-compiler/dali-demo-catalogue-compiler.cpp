@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ * Compiles an example manifest (see resources/catalogues/dali-demo.manifest) into the binary
+ * catalogue the launcher maps at start up.
+ *
+ * Usage: dali-demo-catalogue-compiler <manifest> <catalogue>
+ */
+
+// EXTERNAL INCLUDES
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// INTERNAL INCLUDES
+#include "demo/example-catalogue-format.h"
+
+namespace
+{
+
+const unsigned int MINIMUM_FIELDS = 3u; ///< The name, title id and title are required
+const unsigned int MAXIMUM_FIELDS = 6u;
+
+struct ManifestEntry
+{
+  std::string name;
+  std::string titleId;
+  std::string title;
+  std::string icon;
+  std::string tags;
+  int         weight;
+};
+
+bool CompareEntries( const ManifestEntry& lhs, const ManifestEntry& rhs )
+{
+  if( lhs.weight != rhs.weight )
+  {
+    return lhs.weight < rhs.weight;
+  }
+  return lhs.title < rhs.title;
+}
+
+std::string Trim( const std::string& text )
+{
+  const char* whitespace = " \t\r\n";
+  const size_t begin = text.find_first_not_of( whitespace );
+  if( begin == std::string::npos )
+  {
+    return std::string();
+  }
+  return text.substr( begin, text.find_last_not_of( whitespace ) - begin + 1 );
+}
+
+/**
+ * Reads the entries of a manifest, reporting the first malformed line.
+ */
+bool ReadManifest( const char* path, std::vector<ManifestEntry>& entries )
+{
+  std::ifstream manifest( path );
+  if( !manifest )
+  {
+    std::cerr << path << ": cannot open" << std::endl;
+    return false;
+  }
+
+  std::string line;
+  unsigned int lineNumber = 0u;
+  while( std::getline( manifest, line ) )
+  {
+    ++lineNumber;
+    line = Trim( line );
+    if( line.empty() || line[0] == '#' )
+    {
+      continue;
+    }
+
+    std::vector<std::string> fields;
+    std::istringstream stream( line );
+    std::string field;
+    while( std::getline( stream, field, '|' ) )
+    {
+      fields.push_back( Trim( field ) );
+    }
+    if( line[ line.size() - 1 ] == '|' )
+    {
+      fields.push_back( std::string() );
+    }
+
+    if( fields.size() < MINIMUM_FIELDS || fields.size() > MAXIMUM_FIELDS || fields[0].empty() || fields[2].empty() )
+    {
+      std::cerr << path << ":" << lineNumber << ": expected \"name | title id | title | icon | tags | weight\"" << std::endl;
+      return false;
+    }
+    fields.resize( MAXIMUM_FIELDS );
+
+    ManifestEntry entry;
+    entry.name = fields[0];
+    entry.titleId = fields[1];
+    entry.title = fields[2];
+    entry.icon = fields[3];
+    entry.tags = fields[4];
+    entry.weight = 0;
+    if( !fields[5].empty() )
+    {
+      char* end = NULL;
+      entry.weight = static_cast<int>( strtol( fields[5].c_str(), &end, 10 ) );
+      if( *end != '\0' )
+      {
+        std::cerr << path << ":" << lineNumber << ": the weight \"" << fields[5] << "\" is not a number" << std::endl;
+        return false;
+      }
+    }
+
+    entries.push_back( entry );
+  }
+
+  return true;
+}
+
+/**
+ * Collects strings for the string table, storing each distinct string once.
+ */
+class StringTable
+{
+public:
+  StringTable( uint32_t offset )
+  : mOffset( offset )
+  {
+  }
+
+  uint32_t Add( const std::string& text )
+  {
+    std::map<std::string, uint32_t>::iterator iter = mOffsets.find( text );
+    if( iter != mOffsets.end() )
+    {
+      return iter->second;
+    }
+
+    const uint32_t offset = mOffset + mData.size();
+    mData.insert( mData.end(), text.begin(), text.end() );
+    mData.push_back( '\0' );
+    mOffsets[ text ] = offset;
+    return offset;
+  }
+
+  const std::vector<char>& GetData() const
+  {
+    return mData;
+  }
+
+private:
+  uint32_t                        mOffset;  ///< Where the table is in the file
+  std::vector<char>               mData;
+  std::map<std::string, uint32_t> mOffsets;
+};
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+  if( argc != 3 )
+  {
+    std::cerr << "Usage: " << argv[0] << " <manifest> <catalogue>" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<ManifestEntry> entries;
+  if( !ReadManifest( argv[1], entries ) )
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::stable_sort( entries.begin(), entries.end(), CompareEntries );
+
+  ExampleCatalogueFormat::Header header;
+  header.magic = ExampleCatalogueFormat::MAGIC;
+  header.version = ExampleCatalogueFormat::VERSION;
+  header.count = entries.size();
+  header.stringTableOffset = sizeof( ExampleCatalogueFormat::Header ) + entries.size() * sizeof( ExampleCatalogueFormat::Entry );
+
+  StringTable strings( header.stringTableOffset );
+  strings.Add( std::string() );
+
+  std::vector<ExampleCatalogueFormat::Entry> catalogueEntries( entries.size() );
+  for( size_t i = 0; i < entries.size(); ++i )
+  {
+    catalogueEntries[i].name = strings.Add( entries[i].name );
+    catalogueEntries[i].titleId = strings.Add( entries[i].titleId );
+    catalogueEntries[i].title = strings.Add( entries[i].title );
+    catalogueEntries[i].icon = strings.Add( entries[i].icon );
+    catalogueEntries[i].tags = strings.Add( entries[i].tags );
+    catalogueEntries[i].weight = entries[i].weight;
+  }
+  header.size = header.stringTableOffset + strings.GetData().size();
+
+  FILE* file = fopen( argv[2], "wb" );
+  if( !file )
+  {
+    std::cerr << argv[2] << ": cannot create" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  bool written = fwrite( &header, sizeof( header ), 1, file ) == 1;
+  if( !catalogueEntries.empty() )
+  {
+    written = written && fwrite( &catalogueEntries[0], sizeof( ExampleCatalogueFormat::Entry ), catalogueEntries.size(), file ) == catalogueEntries.size();
+  }
+  written = written && fwrite( &strings.GetData()[0], 1, strings.GetData().size(), file ) == strings.GetData().size();
+  if( fclose( file ) != 0 || !written )
+  {
+    std::cerr << argv[2] << ": cannot write" << std::endl;
+    remove( argv[2] );
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
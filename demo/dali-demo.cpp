@@ -17,13 +17,22 @@
 
 // EXTERNAL INCLUDES
 #include <dali/dali.h>
+#include <cstdlib>
+#include <iostream>
 
 // INTERNAL INCLUDES
 #include "dali-table-view.h"
+#include "example-catalogue.h"
+#include "example-launcher.h"
 #include "shared/dali-demo-strings.h"
 
 using namespace Dali;
 
+namespace
+{
+const char* const CATALOGUE_PATH_ENV = "DALI_DEMO_CATALOGUE"; ///< Overrides the path of the example catalogue
+}
+
 int DALI_EXPORT_API main(int argc, char **argv)
 {
   // Configure gettext for internalization
@@ -31,60 +40,27 @@ int DALI_EXPORT_API main(int argc, char **argv)
   textdomain(DALI_DEMO_DOMAIN_LOCAL);
   setlocale(LC_ALL, DEMO_LANG);
 
-  Application app = Application::New(&argc, &argv, DEMO_THEME_PATH);
+  // The examples to show, from the compiled catalogue; the environment can select another one
+  const char* cataloguePath = getenv( CATALOGUE_PATH_ENV );
+  if( !cataloguePath || !*cataloguePath )
+  {
+    cataloguePath = DEMO_CATALOGUE_PATH;
+  }
 
-  // Create the demo launcher
-  DaliTableView demo(app);
+  ExampleCatalogue catalogue;
+  if( !catalogue.Load( cataloguePath ) )
+  {
+    std::cerr << "Unable to load the example catalogue " << cataloguePath << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Fork the zygote while still single threaded, before the Application starts its threads
+  ExampleLauncher::Initialize();
 
-  demo.AddExample(Example("animated-shapes.example", DALI_DEMO_STR_TITLE_ANIMATED_SHAPES));
-  demo.AddExample(Example("bubble-effect.example", DALI_DEMO_STR_TITLE_BUBBLES));
-  demo.AddExample(Example("blocks.example", DALI_DEMO_STR_TITLE_BLOCKS));
-  demo.AddExample(Example("cube-transition-effect.example", DALI_DEMO_STR_TITLE_CUBE_TRANSITION));
-  demo.AddExample(Example("dissolve-effect.example", DALI_DEMO_STR_TITLE_DISSOLVE_TRANSITION));
-  demo.AddExample(Example("item-view.example", DALI_DEMO_STR_TITLE_ITEM_VIEW));
-  demo.AddExample(Example("renderer-stencil.example", DALI_DEMO_STR_TITLE_RENDERER_STENCIL));
-  demo.AddExample(Example("magnifier.example", DALI_DEMO_STR_TITLE_MAGNIFIER));
-  demo.AddExample(Example("motion-blur.example", DALI_DEMO_STR_TITLE_MOTION_BLUR));
-  demo.AddExample(Example("motion-stretch.example", DALI_DEMO_STR_TITLE_MOTION_STRETCH));
-  demo.AddExample(Example("page-turn-view.example", DALI_DEMO_STR_TITLE_PAGE_TURN_VIEW));
-  demo.AddExample(Example("refraction-effect.example", DALI_DEMO_STR_TITLE_REFRACTION));
-  demo.AddExample(Example("scroll-view.example", DALI_DEMO_STR_TITLE_SCROLL_VIEW));
-  demo.AddExample(Example("shadows-and-lights.example", DALI_DEMO_STR_TITLE_LIGHTS_AND_SHADOWS));
-  demo.AddExample(Example("builder.example", DALI_DEMO_STR_TITLE_SCRIPT_BASED_UI));
-  demo.AddExample(Example("image-scaling-and-filtering.example", DALI_DEMO_STR_TITLE_IMAGE_FITTING_SAMPLING));
-  demo.AddExample(Example("image-scaling-irregular-grid.example", DALI_DEMO_STR_TITLE_IMAGE_SCALING));
-  demo.AddExample(Example("text-field.example", DALI_DEMO_STR_TITLE_TEXT_FIELD));
-  demo.AddExample(Example("text-label.example", DALI_DEMO_STR_TITLE_TEXT_LABEL));
-  demo.AddExample(Example("text-label-multi-language.example", DALI_DEMO_STR_TITLE_TEXT_LABEL_MULTI_LANGUAGE));
-  demo.AddExample(Example("text-label-emojis.example", DALI_DEMO_STR_TITLE_EMOJI_TEXT));
-  demo.AddExample(Example("text-scrolling.example", DALI_DEMO_STR_TITLE_TEXT_SCROLLING));
-  demo.AddExample(Example("text-editor.example", DALI_DEMO_STR_TITLE_TEXT_EDITOR));
-  demo.AddExample(Example("size-negotiation.example", DALI_DEMO_STR_TITLE_NEGOTIATE_SIZE));
-  demo.AddExample(Example("popup.example", DALI_DEMO_STR_TITLE_POPUP));
-  demo.AddExample(Example("buttons.example", DALI_DEMO_STR_TITLE_BUTTONS));
-  demo.AddExample(Example("logging.example", DALI_DEMO_STR_TITLE_LOGGING));
-  demo.AddExample(Example("mesh-morph.example", DALI_DEMO_STR_TITLE_MESH_MORPH));
-  demo.AddExample(Example("mesh-sorting.example", DALI_DEMO_STR_TITLE_MESH_SORTING));
-  demo.AddExample(Example("metaball-explosion.example", DALI_DEMO_STR_TITLE_METABALL_EXPLOSION));
-  demo.AddExample(Example("metaball-refrac.example", DALI_DEMO_STR_TITLE_METABALL_REFRAC));
-  demo.AddExample(Example("textured-mesh.example", DALI_DEMO_STR_TITLE_TEXTURED_MESH));
-  demo.AddExample(Example("line-mesh.example", DALI_DEMO_STR_TITLE_LINE_MESH));
-  demo.AddExample(Example("gradients.example", DALI_DEMO_STR_TITLE_COLOR_GRADIENT));
-  demo.AddExample(Example("image-view.example", DALI_DEMO_STR_TITLE_IMAGE_VIEW));
-  demo.AddExample(Example("image-view-pixel-area.example", DALI_DEMO_STR_TITLE_IMAGE_VIEW_PIXEL_AREA));
-  demo.AddExample(Example("image-view-alpha-blending.example", DALI_DEMO_STR_TITLE_IMAGE_VIEW_ALPHA_BLENDING));
-  demo.AddExample(Example("image-view-svg.example", DALI_DEMO_STR_TITLE_IMAGE_VIEW_SVG));
-  demo.AddExample(Example("super-blur-bloom.example", DALI_DEMO_STR_TITLE_SUPER_BLUR_BLOOM));
-  demo.AddExample(Example("tilt.example", DALI_DEMO_STR_TITLE_TILT_SENSOR));
-  demo.AddExample(Example("effects-view.example", DALI_DEMO_STR_TITLE_EFFECTS_VIEW));
-  demo.AddExample(Example("native-image-source.example", DALI_DEMO_STR_TITLE_NATIVE_IMAGE_SOURCE));
-  demo.AddExample(Example("mesh-visual.example", DALI_DEMO_STR_TITLE_MESH_VISUAL));
-  demo.AddExample(Example("primitive-shapes.example", DALI_DEMO_STR_TITLE_PRIMITIVE_SHAPES));
-  demo.AddExample(Example("styling.example", DALI_DEMO_STR_TITLE_STYLING));
-  demo.AddExample(Example("sparkle.example", DALI_DEMO_STR_TITLE_SPARKLE));
-  demo.AddExample(Example("progress-bar.example", DALI_DEMO_STR_TITLE_PROGRESS_BAR));
+  Application app = Application::New(&argc, &argv, DEMO_THEME_PATH);
 
-  demo.SortAlphabetically( true );
+  // Create the demo launcher
+  DaliTableView demo( app, catalogue );
 
   // Start the event loop
   app.MainLoop();
@@ -20,17 +20,21 @@
 
 // EXTERNAL INCLUDES
 #include <algorithm>
+#include <cstdlib>
+#include <iostream>
 #include <sstream>
 #include <unistd.h>
-#include <dali/devel-api/images/distance-field.h>
 #include <dali-toolkit/devel-api/shader-effects/alpha-discard-effect.h>
-#include <dali-toolkit/devel-api/shader-effects/distance-field-effect.h>
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali-toolkit/devel-api/visual-factory/visual-factory.h>
+#include <dali/devel-api/images/texture-set-image.h>
 
 // INTERNAL INCLUDES
 #include "shared/view.h"
 #include "shared/utility.h"
+#include "distance-field-cache.h"
+#include "example-catalogue.h"
+#include "example-launcher.h"
 
 using namespace Dali;
 using namespace Dali::Toolkit;
@@ -83,18 +87,22 @@ const Vector4 BUBBLE_COLOR[] =
 const int NUMBER_OF_BUBBLE_COLOR( sizeof(BUBBLE_COLOR) / sizeof(BUBBLE_COLOR[0]) );
 
 const int NUM_BACKGROUND_IMAGES = 18;
+const float BUBBLE_LOOP_DURATION = 160.0f;                      ///< Seconds for the bubble animation to loop
+const float BUBBLE_MAX_CYCLES = 5.0f;                           ///< The most times a bubble crosses the screen per loop
 const float BACKGROUND_SWIPE_SCALE = 0.025f;
 const float BACKGROUND_SPREAD_SCALE = 1.5f;
 const float SCALE_MOD = 1000.0f * Math::PI * 2.0f;
 const float SCALE_SPEED = 10.0f;
 const float SCALE_SPEED_SIN = 0.1f;
 
-const unsigned int BACKGROUND_ANIMATION_DURATION = 15000; // 15 secs
+const unsigned int DEFAULT_IDLE_TIMEOUT = 15000; // Milliseconds without input before the launcher goes idle
+const char* const IDLE_TIMEOUT_ENV = "DALI_DEMO_IDLE_TIMEOUT"; // Overrides the idle timeout, in seconds; 0 never goes idle
+const unsigned int LAUNCH_REPORT_POLL_INTERVAL = 500; // Milliseconds between reads of the launch timing reported by started examples
 
 const Vector4 BACKGROUND_COLOR( 0.3569f, 0.5451f, 0.7294f, 1.0f );
 
-const float BUBBLE_MIN_Z = -1.0;
-const float BUBBLE_MAX_Z = 0.0f;
+const unsigned int DISTANCE_FIELD_SIZE = 512u; ///< Width and height of the background shapes' distance fields
+const float DISTANCE_FIELD_SPREAD = 8.0f; ///< Pixels over which the background shapes fade from inside to outside
 
 // This shader takes a texture.
 // An alpha discard is performed.
@@ -137,36 +145,80 @@ Control CreateBackground( std::string stylename )
 }
 
 /**
- * Constraint to return a position for a bubble based on the scroll value and vertical wrapping
+ * Returns how long the launcher waits without input before going idle, in milliseconds, 0 for never.
  */
-struct AnimateBubbleConstraint
+unsigned int GetIdleTimeout()
 {
-public:
-  AnimateBubbleConstraint( const Vector3& initialPos, float scale )
-  : mInitialX( initialPos.x ),
-    mScale( scale )
+  const char* timeout = getenv( IDLE_TIMEOUT_ENV );
+  if( timeout && *timeout )
   {
+    return static_cast<unsigned int>( std::max( 0.0, atof( timeout ) ) * 1000.0 );
   }
 
-  void operator()( Vector3& position, const PropertyInputContainer& inputs )
-  {
-    const Vector3& parentSize = inputs[1]->GetVector3();
-    const Vector3& childSize = inputs[2]->GetVector3();
+  return DEFAULT_IDLE_TIMEOUT;
+}
+
+/**
+ * The vertex of a corner of a bubble. All the bubbles are drawn from one geometry.
+ */
+struct BubbleVertex
+{
+  Vector2 corner;      ///< The corner of the bubble, from (-0.5, -0.5) to (0.5, 0.5)
+  Vector2 sizeShape;   ///< The size of the bubble in pixels, and its shape: 0 for a circle, 1 for a bubble
+  Vector4 motion;      ///< Horizontal position as a multiple of the width, vertical phase, vertical cycles per loop and parallax scale
+  Vector4 color;
+};
 
-    // Wrap bubbles vertically.
-    float range = parentSize.y + childSize.y;
-    // This performs a float mod (we don't use fmod as we want the arithmetic modulus as opposed to the remainder).
-    position.y -= range * ( floor( position.y / range ) + 0.5f );
+// This shader draws all the background bubbles.
+// Each bubble moves up at its own speed, wrapping vertically around the container, and moves parallax to
+// the horizontal scroll by its own scale. It is done here, from two uniforms, rather than with an actor,
+// a constraint and an animation per bubble.
+const char* VERTEX_SHADER_BUBBLES = DALI_COMPOSE_SHADER(
+  attribute mediump vec2  aCorner;
+  attribute mediump vec2  aSizeShape;
+  attribute mediump vec4  aMotion;
+  attribute mediump vec4  aColor;
+  uniform   mediump mat4  uMvpMatrix;
+  uniform   mediump vec3  uSize;
+  uniform   mediump vec2  uScrollPosition;
+  uniform   mediump float uTime;
+  uniform   mediump float uSmoothing;
+  varying   mediump vec2  vTexCoord;
+  varying   mediump float vShape;
+  varying   mediump float vSmoothing;
+  varying   lowp    vec4  vColor;
 
-    // Bubbles X position moves parallax to horizontal
-    // panning by a scale factor unique to each bubble.
-    position.x = mInitialX + ( inputs[0]->GetVector2().x * mScale );
+  void main()
+  {
+    // A bubble makes a whole number of cycles per loop of uTime, so the loop is seamless.
+    mediump float range = uSize.y + aSizeShape.x;
+    mediump float y = ( fract( aMotion.y - uTime * aMotion.z ) - 0.5 ) * range;
+    mediump float x = aMotion.x * uSize.x + uScrollPosition.x * aMotion.w;
+
+    gl_Position = uMvpMatrix * vec4( vec2( x, y ) + aCorner * aSizeShape.x, 0.0, 1.0 );
+    vTexCoord = aCorner + vec2( 0.5 );
+    vShape = aSizeShape.y;
+    vSmoothing = min( uSmoothing / aSizeShape.x, 0.5 );
+    vColor = aColor;
   }
+);
 
-private:
-  float mInitialX;
-  float mScale;
-};
+const char* FRAGMENT_SHADER_BUBBLES = DALI_COMPOSE_SHADER(
+  uniform sampler2D      sCircle;
+  uniform sampler2D      sBubble;
+  uniform lowp    vec4   uColor;
+  varying mediump vec2   vTexCoord;
+  varying mediump float  vShape;
+  varying mediump float  vSmoothing;
+  varying lowp    vec4   vColor;
+
+  void main()
+  {
+    mediump float distance = mix( texture2D( sCircle, vTexCoord ).a, texture2D( sBubble, vTexCoord ).a, vShape );
+    lowp float alpha = smoothstep( 0.5 - vSmoothing, 0.5 + vSmoothing, distance );
+    gl_FragColor = vec4( vColor.rgb, vColor.a * alpha ) * uColor;
+  }
+);
 
 /**
  * Constraint to precalculate values from the scroll-view
@@ -203,14 +255,9 @@ private:
   float mTileXOffset;
 };
 
-bool CompareByTitle( const Example& lhs, const Example& rhs )
-{
-  return lhs.title < rhs.title;
-}
-
 } // namespace
 
-DaliTableView::DaliTableView( Application& application )
+DaliTableView::DaliTableView( Application& application, const ExampleCatalogue& catalogue )
 : mApplication( application ),
   mRootActor(),
   mRotateAnimation(),
@@ -220,16 +267,18 @@ DaliTableView::DaliTableView( Application& application )
   mScrollRulerX(),
   mScrollRulerY(),
   mPressedActor(),
-  mAnimationTimer(),
+  mIdleTimer(),
+  mLaunchReportTimer(),
   mLogoTapDetector(),
   mVersionPopup(),
   mPages(),
   mBackgroundAnimations(),
-  mExampleList(),
+  mCatalogue( catalogue ),
   mTotalPages(),
+  mPressTime( 0u ),
+  mPowerState( ACTIVE ),
   mScrolling( false ),
-  mSortAlphabetically( false ),
-  mBackgroundAnimsPlaying( false )
+  mPageBuildQueued( false )
 {
   application.InitSignal().Connect( this, &DaliTableView::Initialize );
 }
@@ -238,19 +287,10 @@ DaliTableView::~DaliTableView()
 {
 }
 
-void DaliTableView::AddExample( Example example )
-{
-  mExampleList.push_back( example );
-}
-
-void DaliTableView::SortAlphabetically( bool sortAlphabetically )
-{
-  mSortAlphabetically = sortAlphabetically;
-}
-
 void DaliTableView::Initialize( Application& application )
 {
   Stage::GetCurrent().KeyEventSignal().Connect( this, &DaliTableView::OnKeyEvent );
+  Stage::GetCurrent().TouchSignal().Connect( this, &DaliTableView::OnStageTouched );
   const Vector2 stageSize = Stage::GetCurrent().GetSize();
 
   // Background
@@ -306,9 +346,6 @@ void DaliTableView::Initialize( Application& application )
   // Add pages and tiles
   Populate();
 
-  // Remove constraints for inner cube effect
-  ApplyCubeEffectToPages();
-
   Dali::Window winHandle = application.GetWindow();
   winHandle.AddAvailableOrientation( Dali::Window::PORTRAIT );
   winHandle.RemoveAvailableOrientation( Dali::Window::LANDSCAPE );
@@ -321,13 +358,16 @@ void DaliTableView::Initialize( Application& application )
 
   winHandle.ShowIndicator( Dali::Window::INVISIBLE );
 
-  // Background animation
-  mAnimationTimer = Timer::New( BACKGROUND_ANIMATION_DURATION );
-  mAnimationTimer.TickSignal().Connect( this, &DaliTableView::PauseBackgroundAnimation );
-  mAnimationTimer.Start();
-  mBackgroundAnimsPlaying = true;
-
   CreateFocusEffect();
+
+  // Go idle when there is no input for a while
+  const unsigned int idleTimeout = GetIdleTimeout();
+  if( idleTimeout > 0u )
+  {
+    mIdleTimer = Timer::New( idleTimeout );
+    mIdleTimer.TickSignal().Connect( this, &DaliTableView::OnIdleTimer );
+    mIdleTimer.Start();
+  }
 }
 
 void DaliTableView::CreateFocusEffect()
@@ -373,105 +413,131 @@ void DaliTableView::CreateFocusEffect()
   KeyboardFocusManager::Get().SetFocusIndicatorActor( mFocusEffect[0].actor );
 }
 
-void DaliTableView::ApplyCubeEffectToPages()
+void DaliTableView::OnButtonsPageRelayout( const Dali::Actor& actor )
 {
-  ScrollViewPagePathEffect effect = ScrollViewPagePathEffect::DownCast( mScrollViewEffect );
-  unsigned int pageCount(0);
-  for( std::vector< Actor >::iterator pageIter = mPages.begin(); pageIter != mPages.end(); ++pageIter )
-  {
-    Actor page = *pageIter;
-    effect.ApplyToPage( page, pageCount++ );
-  }
 }
 
-void DaliTableView::OnButtonsPageRelayout( const Dali::Actor& actor )
+void DaliTableView::Populate()
 {
+  const Vector2 stageSize = Stage::GetCurrent().GetSize();
+
+  mTotalPages = ( mCatalogue.GetCount() + EXAMPLES_PER_PAGE - 1 ) / EXAMPLES_PER_PAGE;
+
+  // Only the first page and its neighbour are created now, the rest when the application is idle.
+  mPages.assign( mTotalPages, Actor() );
+  BuildPagesAround( 0 );
+
+  // Update Ruler info.
+  mScrollRulerX = new FixedRuler( mPageWidth );
+  mScrollRulerY = new DefaultRuler();
+  mScrollRulerX->SetDomain( RulerDomain( 0.0f, (mTotalPages+1) * stageSize.width * TABLE_RELATIVE_SIZE.x * 0.5f, true ) );
+  mScrollRulerY->Disable();
+  mScrollView.SetRulerX( mScrollRulerX );
+  mScrollView.SetRulerY( mScrollRulerY );
 }
 
-void DaliTableView::Populate()
+Actor DaliTableView::GetPage( int pageIndex )
+{
+  if( !mPages[ pageIndex ] )
+  {
+    CreatePage( pageIndex );
+  }
+
+  return mPages[ pageIndex ];
+}
+
+void DaliTableView::CreatePage( int pageIndex )
 {
   const Vector2 stageSize = Stage::GetCurrent().GetSize();
 
-  mTotalPages = ( mExampleList.size() + EXAMPLES_PER_PAGE - 1 ) / EXAMPLES_PER_PAGE;
+  // Create Table
+  TableView page = TableView::New( ROWS_PER_PAGE, EXAMPLES_PER_ROW );
+  page.SetAnchorPoint( AnchorPoint::CENTER );
+  page.SetParentOrigin( ParentOrigin::CENTER );
+  page.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::ALL_DIMENSIONS );
+  mScrollView.Add( page );
+
+  // Calculate the number of images going across (columns) within a page, according to the screen resolution and dpi.
+  const float margin = 2.0f;
+  const float tileParentMultiplier = 1.0f / EXAMPLES_PER_ROW;
 
-  // Populate ScrollView.
-  if( mExampleList.size() > 0 )
+  const unsigned int firstExample = pageIndex * EXAMPLES_PER_PAGE;
+  const unsigned int lastExample = std::min( firstExample + EXAMPLES_PER_PAGE, mCatalogue.GetCount() );
+  AccessibilityManager accessibilityManager = AccessibilityManager::Get();
+
+  for( unsigned int exampleIndex = firstExample; exampleIndex < lastExample; ++exampleIndex )
   {
-    if( mSortAlphabetically )
-    {
-      sort( mExampleList.begin(), mExampleList.end(), CompareByTitle );
-    }
+    const char* title = mCatalogue.GetTitle( exampleIndex );
+    const int row = ( exampleIndex - firstExample ) / EXAMPLES_PER_ROW;
+    const int column = ( exampleIndex - firstExample ) % EXAMPLES_PER_ROW;
+
+    // Calculate the tiles relative position on the page (between 0 & 1 in each dimension).
+    Vector2 position( static_cast<float>( column ) / ( EXAMPLES_PER_ROW - 1.0f ), static_cast<float>( row ) / ( EXAMPLES_PER_ROW - 1.0f ) );
+    Actor tile = CreateTile( mCatalogue.GetName( exampleIndex ), title, Vector3( tileParentMultiplier, tileParentMultiplier, 1.0f ), position );
+    accessibilityManager.SetFocusOrder( tile, exampleIndex + 1 );
+    accessibilityManager.SetAccessibilityAttribute( tile, Dali::Toolkit::AccessibilityManager::ACCESSIBILITY_LABEL,
+                                            title );
+    accessibilityManager.SetAccessibilityAttribute( tile, Dali::Toolkit::AccessibilityManager::ACCESSIBILITY_TRAIT, "Tile" );
+    accessibilityManager.SetAccessibilityAttribute( tile, Dali::Toolkit::AccessibilityManager::ACCESSIBILITY_HINT,
+                                            "You can run this example" );
+
+    tile.SetPadding( Padding( margin, margin, margin, margin ) );
+    page.AddChild( tile, TableView::CellPosition( row, column ) );
+  }
 
-    unsigned int exampleCount = 0;
-    ExampleListConstIter iter = mExampleList.begin();
+  // Set tableview position
+  Vector3 pagePos( stageSize.width * TABLE_RELATIVE_SIZE.x * pageIndex, 0.0f, 0.0f );
+  page.SetPosition( pagePos );
 
-    for( int t = 0; t < mTotalPages; t++ )
-    {
-      // Create Table
-      TableView page = TableView::New( ROWS_PER_PAGE, EXAMPLES_PER_ROW );
-      page.SetAnchorPoint( AnchorPoint::CENTER );
-      page.SetParentOrigin( ParentOrigin::CENTER );
-      page.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::ALL_DIMENSIONS );
-      mScrollView.Add( page );
-
-      // Calculate the number of images going across (columns) within a page, according to the screen resolution and dpi.
-      const float margin = 2.0f;
-      const float tileParentMultiplier = 1.0f / EXAMPLES_PER_ROW;
-
-      for(int row = 0; row < ROWS_PER_PAGE; row++)
-      {
-        for(int column = 0; column < EXAMPLES_PER_ROW; column++)
-        {
-          const Example& example = ( *iter );
-
-          // Calculate the tiles relative position on the page (between 0 & 1 in each dimension).
-          Vector2 position( static_cast<float>( column ) / ( EXAMPLES_PER_ROW - 1.0f ), static_cast<float>( row ) / ( EXAMPLES_PER_ROW - 1.0f ) );
-          Actor tile = CreateTile( example.name, example.title, Vector3( tileParentMultiplier, tileParentMultiplier, 1.0f ), position );
-          AccessibilityManager accessibilityManager = AccessibilityManager::Get();
-          accessibilityManager.SetFocusOrder( tile, ++exampleCount );
-          accessibilityManager.SetAccessibilityAttribute( tile, Dali::Toolkit::AccessibilityManager::ACCESSIBILITY_LABEL,
-                                                  example.title );
-          accessibilityManager.SetAccessibilityAttribute( tile, Dali::Toolkit::AccessibilityManager::ACCESSIBILITY_TRAIT, "Tile" );
-          accessibilityManager.SetAccessibilityAttribute( tile, Dali::Toolkit::AccessibilityManager::ACCESSIBILITY_HINT,
-                                                  "You can run this example" );
-
-          tile.SetPadding( Padding( margin, margin, margin, margin ) );
-          page.AddChild( tile, TableView::CellPosition( row, column ) );
-
-          iter++;
-
-          if( iter == mExampleList.end() )
-          {
-            break;
-          }
-        }
-
-        if( iter == mExampleList.end() )
-        {
-          break;
-        }
-      }
+  // Apply the inner cube effect
+  ScrollViewPagePathEffect effect = ScrollViewPagePathEffect::DownCast( mScrollViewEffect );
+  effect.ApplyToPage( page, pageIndex );
 
-      // Set tableview position
-      Vector3 pagePos( stageSize.width * TABLE_RELATIVE_SIZE.x * t, 0.0f, 0.0f );
-      page.SetPosition( pagePos );
+  mPages[ pageIndex ] = page;
+}
 
-      mPages.push_back( page );
+void DaliTableView::BuildPagesAround( int pageIndex )
+{
+  // The neighbours can be seen while scrolling, so must be ready before the scroll starts.
+  const int firstPage = std::max( 0, pageIndex - 1 );
+  const int lastPage = std::min( mTotalPages - 1, pageIndex + 1 );
+  for( int page = firstPage; page <= lastPage; ++page )
+  {
+    GetPage( page );
+  }
 
-      if( iter == mExampleList.end() )
-      {
-        break;
-      }
+  QueueIdlePageBuild();
+}
+
+void DaliTableView::QueueIdlePageBuild()
+{
+  if( !mPageBuildQueued && std::find( mPages.begin(), mPages.end(), Actor() ) != mPages.end() )
+  {
+    mPageBuildQueued = mApplication.AddIdle( MakeCallback( this, &DaliTableView::OnIdleBuildPage ) );
+  }
+}
+
+void DaliTableView::OnIdleBuildPage()
+{
+  mPageBuildQueued = false;
+
+  // Build the missing page nearest the current one, then wait for the next idle.
+  const int currentPage = mScrollView.GetCurrentPage();
+  for( int distance = 0; distance < mTotalPages; ++distance )
+  {
+    if( currentPage + distance < mTotalPages && !mPages[ currentPage + distance ] )
+    {
+      CreatePage( currentPage + distance );
+      break;
+    }
+    if( currentPage - distance >= 0 && !mPages[ currentPage - distance ] )
+    {
+      CreatePage( currentPage - distance );
+      break;
     }
   }
 
-  // Update Ruler info.
-  mScrollRulerX = new FixedRuler( mPageWidth );
-  mScrollRulerY = new DefaultRuler();
-  mScrollRulerX->SetDomain( RulerDomain( 0.0f, (mTotalPages+1) * stageSize.width * TABLE_RELATIVE_SIZE.x * 0.5f, true ) );
-  mScrollRulerY->Disable();
-  mScrollView.SetRulerX( mScrollRulerX );
-  mScrollView.SetRulerY( mScrollRulerY );
+  QueueIdlePageBuild();
 }
 
 void DaliTableView::Rotate( unsigned int degrees )
@@ -587,16 +653,11 @@ bool DaliTableView::DoTilePress( Actor actor, PointState::Type pointState )
     // ignore Example button presses when scrolling or button animating.
     if( ( !mScrolling ) && ( !mPressedAnimation ) )
     {
-      std::string name = actor.GetName();
-      const ExampleListIter end = mExampleList.end();
-      for( ExampleListIter iter = mExampleList.begin(); iter != end; ++iter )
+      if( mCatalogue.Find( actor.GetName() ) >= 0 )
       {
-        if( (*iter).name == name )
-        {
-          // do nothing, until pressed animation finished.
-          consumed = true;
-          break;
-        }
+        // do nothing, until pressed animation finished.
+        mPressTime = ExampleLauncher::GetClock();
+        consumed = true;
       }
     }
 
@@ -627,17 +688,15 @@ void DaliTableView::OnPressedAnimationFinished( Dali::Animation& source )
   mPressedAnimation.Reset();
   if( mPressedActor )
   {
-    std::string name = mPressedActor.GetName();
+    ExampleLauncher::Launch( mPressedActor.GetName(), mPressTime );
+    mPressedActor.Reset();
 
-    std::stringstream stream;
-    stream << DEMO_EXAMPLE_BIN << name.c_str();
-    pid_t pid = fork();
-    if( pid == 0)
+    if( !mLaunchReportTimer )
     {
-      execlp( stream.str().c_str(), name.c_str(), NULL );
-      DALI_ASSERT_ALWAYS(false && "exec failed!");
+      mLaunchReportTimer = Timer::New( LAUNCH_REPORT_POLL_INTERVAL );
+      mLaunchReportTimer.TickSignal().Connect( this, &DaliTableView::OnLaunchReportTimer );
     }
-    mPressedActor.Reset();
+    mLaunchReportTimer.Start();
   }
 }
 
@@ -645,16 +704,23 @@ void DaliTableView::OnScrollStart( const Dali::Vector2& position )
 {
   mScrolling = true;
 
-  PlayAnimation();
+  BuildPagesAround( mScrollView.GetCurrentPage() );
+
+  OnActivity();
 }
 
 void DaliTableView::OnScrollComplete( const Dali::Vector2& position )
 {
   mScrolling = false;
 
+  const int currentPage = mScrollView.GetCurrentPage();
+  BuildPagesAround( currentPage );
+
+  OnActivity();
+
   // move focus to 1st item of new page
   AccessibilityManager accessibilityManager = AccessibilityManager::Get();
-  accessibilityManager.SetCurrentFocusActor(mPages[mScrollView.GetCurrentPage()].GetChildAt(0) );
+  accessibilityManager.SetCurrentFocusActor( GetPage( currentPage ).GetChildAt(0) );
 }
 
 bool DaliTableView::OnScrollTouched( Actor actor, const TouchData& event )
@@ -711,6 +777,8 @@ void DaliTableView::SetupInnerPageCubeEffect()
 
 void DaliTableView::OnKeyEvent( const KeyEvent& event )
 {
+  OnActivity();
+
   if( event.state == KeyEvent::Down )
   {
     if ( IsKey( event, Dali::DALI_KEY_ESCAPE) || IsKey( event, Dali::DALI_KEY_BACK) )
@@ -733,159 +801,182 @@ void DaliTableView::SetupBackground( Actor bubbleContainer )
 {
   // Create distance field shapes.
   BufferImage distanceFields[2];
-  Size imageSize( 512, 512 );
+  Size imageSize( DISTANCE_FIELD_SIZE, DISTANCE_FIELD_SIZE );
 
   CreateShapeImage( CIRCLE, imageSize, distanceFields[0] );
   CreateShapeImage( BUBBLE, imageSize, distanceFields[1] );
 
   // Add bubbles to the bubbleContainer.
   // Note: The bubbleContainer is parented externally to this function.
-  AddBackgroundActors( bubbleContainer, NUM_BACKGROUND_IMAGES, distanceFields );
+  AddBubbleField( bubbleContainer, NUM_BACKGROUND_IMAGES, distanceFields );
 }
 
-void DaliTableView::InitialiseBackgroundActors( Actor actor )
+void DaliTableView::AddBubbleField( Actor layer, int count, BufferImage* distanceField )
 {
-  // Delete current animations
-  mBackgroundAnimations.clear();
-
-  // Create new animations
-  const Vector3 size = actor.GetTargetSize();
-
-  for( unsigned int i = 0, childCount = actor.GetChildCount(); i < childCount; ++i )
-  {
-    Actor child = actor.GetChildAt( i );
-
-    // Calculate a random position
-    Vector3 childPos( Random::Range( -size.x * 0.5f * BACKGROUND_SPREAD_SCALE, size.x * 0.85f * BACKGROUND_SPREAD_SCALE ),
-                      Random::Range( -size.y, size.y ),
-                      Random::Range( BUBBLE_MIN_Z, BUBBLE_MAX_Z ) );
-
-    child.SetPosition( childPos );
-
-    // Define bubble horizontal parallax and vertical wrapping
-    Constraint animConstraint = Constraint::New < Vector3 > ( child, Actor::Property::POSITION, AnimateBubbleConstraint( childPos, Random::Range( -0.85f, 0.25f ) ) );
-    animConstraint.AddSource( Source( mScrollView, ScrollView::Property::SCROLL_POSITION ) );
-    animConstraint.AddSource( Dali::ParentSource( Dali::Actor::Property::SIZE ) );
-    animConstraint.AddSource( Dali::LocalSource( Dali::Actor::Property::SIZE ) );
-    animConstraint.SetRemoveAction( Constraint::Discard );
-    animConstraint.Apply();
-
-    // Kickoff animation
-    Animation animation = Animation::New( Random::Range( 30.0f, 160.0f ) );
-    animation.AnimateBy( Property( child, Actor::Property::POSITION ), Vector3( 0.0f, -2000.0f, 0.0f ), AlphaFunction::LINEAR );
-    animation.SetLooping( true );
-    animation.Play();
-    mBackgroundAnimations.push_back( animation );
-  }
-}
+  // Four vertices and two triangles per bubble
+  std::vector< BubbleVertex > vertices( count * 4 );
+  std::vector< unsigned short > indices( count * 6 );
+  const Vector2 corners[] = { Vector2( -0.5f, -0.5f ), Vector2( 0.5f, -0.5f ), Vector2( -0.5f, 0.5f ), Vector2( 0.5f, 0.5f ) };
 
-void DaliTableView::AddBackgroundActors( Actor layer, int count, BufferImage* distanceField )
-{
   for( int i = 0; i < count; ++i )
   {
-    float randSize = Random::Range( 10.0f, 400.0f );
-    int distanceFieldType = static_cast<int>( Random::Range( 0.0f, 1.0f ) + 0.5f );
-    ImageView dfActor = ImageView::New( distanceField[ distanceFieldType ] );
-    dfActor.SetSize( Vector2( randSize, randSize ) );
-    dfActor.SetParentOrigin( ParentOrigin::CENTER );
-
-    Dali::Property::Map effect = Toolkit::CreateDistanceFieldEffect();
-    dfActor.SetProperty( Toolkit::ImageView::Property::IMAGE, effect );
-    dfActor.SetColor( BUBBLE_COLOR[ i%NUMBER_OF_BUBBLE_COLOR ] );
+    const float size = Random::Range( 10.0f, 400.0f );
+    const float shape = static_cast<int>( Random::Range( 0.0f, 1.0f ) + 0.5f );
+    const Vector4 motion( Random::Range( -0.5f * BACKGROUND_SPREAD_SCALE, 0.85f * BACKGROUND_SPREAD_SCALE ),
+                          Random::Range( 0.0f, 1.0f ),
+                          floor( Random::Range( 1.0f, BUBBLE_MAX_CYCLES + 1.0f ) ),
+                          Random::Range( -0.85f, 0.25f ) );
+
+    for( int corner = 0; corner < 4; ++corner )
+    {
+      BubbleVertex& vertex = vertices[ i * 4 + corner ];
+      vertex.corner = corners[ corner ];
+      vertex.sizeShape = Vector2( size, shape );
+      vertex.motion = motion;
+      vertex.color = BUBBLE_COLOR[ i % NUMBER_OF_BUBBLE_COLOR ];
+    }
 
-    layer.Add( dfActor );
+    const unsigned short first = i * 4;
+    const unsigned short quad[] = { first, static_cast<unsigned short>( first + 2 ), static_cast<unsigned short>( first + 1 ),
+                                    static_cast<unsigned short>( first + 1 ), static_cast<unsigned short>( first + 2 ), static_cast<unsigned short>( first + 3 ) };
+    std::copy( quad, quad + 6, indices.begin() + i * 6 );
   }
 
-  // Positioning will occur when the layer is relaid out
-  layer.OnRelayoutSignal().Connect( this, &DaliTableView::InitialiseBackgroundActors );
+  Property::Map vertexFormat;
+  vertexFormat["aCorner"] = Property::VECTOR2;
+  vertexFormat["aSizeShape"] = Property::VECTOR2;
+  vertexFormat["aMotion"] = Property::VECTOR4;
+  vertexFormat["aColor"] = Property::VECTOR4;
+  PropertyBuffer vertexBuffer = PropertyBuffer::New( vertexFormat );
+  vertexBuffer.SetData( &vertices[0], vertices.size() );
+
+  Geometry geometry = Geometry::New();
+  geometry.AddVertexBuffer( vertexBuffer );
+  geometry.SetIndexBuffer( &indices[0], indices.size() );
+
+  Shader shader = Shader::New( VERTEX_SHADER_BUBBLES, FRAGMENT_SHADER_BUBBLES );
+
+  TextureSet textureSet = TextureSet::New();
+  TextureSetImage( textureSet, 0u, distanceField[0] );
+  TextureSetImage( textureSet, 1u, distanceField[1] );
+
+  Renderer renderer = Renderer::New( geometry, shader );
+  renderer.SetTextures( textureSet );
+  renderer.SetProperty( Renderer::Property::BLEND_MODE, BlendMode::ON );
+
+  Actor bubbles = Actor::New();
+  bubbles.SetName( "BUBBLES" );
+  bubbles.SetAnchorPoint( AnchorPoint::CENTER );
+  bubbles.SetParentOrigin( ParentOrigin::CENTER );
+  bubbles.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::ALL_DIMENSIONS );
+  bubbles.AddRenderer( renderer );
+
+  // The shader fades the edges over about a pixel, whatever the size of the bubble.
+  bubbles.RegisterProperty( "uSmoothing", DISTANCE_FIELD_SIZE / ( 2.0f * DISTANCE_FIELD_SPREAD ) );
+
+  // One constraint passes the scroll position to every bubble.
+  Property::Index scrollPositionIndex = bubbles.RegisterProperty( "uScrollPosition", Vector2::ZERO );
+  Constraint scrollPosition = Constraint::New< Vector2 >( bubbles, scrollPositionIndex, EqualToConstraint() );
+  scrollPosition.AddSource( Source( mScrollView, ScrollView::Property::SCROLL_POSITION ) );
+  scrollPosition.Apply();
+
+  // One animation moves every bubble.
+  Property::Index timeIndex = bubbles.RegisterProperty( "uTime", 0.0f );
+  KeyFrames keyFrames = KeyFrames::New();
+  keyFrames.Add( 0.0f, 0.0f );
+  keyFrames.Add( 1.0f, 1.0f );
+  Animation animation = Animation::New( BUBBLE_LOOP_DURATION );
+  animation.AnimateBetween( Property( bubbles, timeIndex ), keyFrames, AlphaFunction::LINEAR );
+  animation.SetLooping( true );
+  animation.Play();
+  mBackgroundAnimations.push_back( animation );
+
+  layer.Add( bubbles );
 }
 
 void DaliTableView::CreateShapeImage( ShapeType shapeType, const Size& size, BufferImage& distanceFieldOut )
 {
-  // this bitmap will hold the alpha map for the distance field shader
-  distanceFieldOut = BufferImage::New( size.width, size.height, Pixel::A8 );
+  DistanceFieldCache::Shape shape = shapeType == BUBBLE ? DistanceFieldCache::BUBBLE : DistanceFieldCache::CIRCLE;
+  distanceFieldOut = DistanceFieldCache::Load( shape, size.width, DISTANCE_FIELD_SPREAD );
+}
 
-  // Generate bit pattern
-  std::vector< unsigned char > imageDataA8;
-  imageDataA8.reserve( size.width * size.height ); // A8
+ImageView DaliTableView::CreateLogo( std::string imagePath )
+{
+  ImageView logo = ImageView::New( imagePath );
 
-  switch( shapeType )
-  {
-    case CIRCLE:
-      GenerateCircle( size, imageDataA8 );
-      break;
-    case BUBBLE:
-      GenerateCircle( size, imageDataA8, true );
-      break;
-    default:
-      break;
-  }
+  logo.SetAnchorPoint( AnchorPoint::CENTER );
+  logo.SetParentOrigin( ParentOrigin::CENTER );
 
-  PixelBuffer* buffer = distanceFieldOut.GetBuffer();
-  if( buffer )
-  {
-    GenerateDistanceFieldMap( &imageDataA8[ 0 ], size, buffer, size, 8.0f, size );
-    distanceFieldOut.Update();
-  }
+  return logo;
 }
 
-void DaliTableView::GenerateCircle( const Size& size, std::vector< unsigned char >& distanceFieldOut, bool hollow )
+bool DaliTableView::OnIdleTimer()
 {
-  const float radius = size.width * 0.5f * size.width * 0.5f;
-  Vector2 center( size.width / 2, size.height / 2 );
-
-  for( int h = 0; h < size.height; ++h )
+  // Keep waiting while the user is scrolling
+  if( mScrolling )
   {
-    for( int w = 0; w < size.width; ++w )
-    {
-      Vector2 pos( w, h );
-      Vector2 dist = pos - center;
-
-      float distance = ( dist.x * dist.x ) + ( dist.y * dist.y );
+    return true;
+  }
 
-      // If hollow, check the distance against a min & max value, otherwise just use the max value.
-      unsigned char fillByte = ( hollow ? ( ( distance <= radius ) && ( distance > ( radius * 0.7f ) ) ) : ( distance <= radius ) ) ? 0xFF : 0x00;
+  EnterIdleMode();
 
-      distanceFieldOut.push_back( fillByte );
-    }
-  }
+  return false;
 }
 
-ImageView DaliTableView::CreateLogo( std::string imagePath )
+void DaliTableView::OnStageTouched( const TouchData& touch )
 {
-  ImageView logo = ImageView::New( imagePath );
+  OnActivity();
+}
 
-  logo.SetAnchorPoint( AnchorPoint::CENTER );
-  logo.SetParentOrigin( ParentOrigin::CENTER );
+bool DaliTableView::OnLaunchReportTimer()
+{
+  if( ExampleLauncher::ReadLaunchReports() )
+  {
+    ExampleLauncher::PrintLaunchTimes( std::cout );
+  }
 
-  return logo;
+  return ExampleLauncher::IsWaitingForReports();
 }
 
-bool DaliTableView::PauseBackgroundAnimation()
+void DaliTableView::OnActivity()
 {
-  PauseAnimation();
+  if( mPowerState == IDLE )
+  {
+    ExitIdleMode();
+  }
 
-  return false;
+  // Restart the countdown
+  if( mIdleTimer )
+  {
+    mIdleTimer.SetInterval( mIdleTimer.GetInterval() );
+  }
 }
 
-void DaliTableView::PauseAnimation()
+void DaliTableView::EnterIdleMode()
 {
-  if( mBackgroundAnimsPlaying )
+  if( mPowerState == ACTIVE )
   {
+    // Once nothing animates, DALi stops updating and rendering until something changes.
+    // The constraints are only evaluated by an update, so they stop too.
     for( AnimationListIter animIter = mBackgroundAnimations.begin(); animIter != mBackgroundAnimations.end(); ++animIter )
     {
       Animation anim = *animIter;
 
-      anim.Stop();
+      anim.Pause();
+    }
+
+    for( unsigned int i = 0; i < FOCUS_ANIMATION_ACTOR_NUMBER; ++i )
+    {
+      mFocusEffect[i].animation.Pause();
     }
 
-    mBackgroundAnimsPlaying = false;
+    mPowerState = IDLE;
   }
 }
 
-void DaliTableView::PlayAnimation()
+void DaliTableView::ExitIdleMode()
 {
-  if ( !mBackgroundAnimsPlaying )
+  if( mPowerState == IDLE )
   {
     for( AnimationListIter animIter = mBackgroundAnimations.begin(); animIter != mBackgroundAnimations.end(); ++animIter )
     {
@@ -894,10 +985,13 @@ void DaliTableView::PlayAnimation()
       anim.Play();
     }
 
-    mBackgroundAnimsPlaying = true;
-  }
+    for( unsigned int i = 0; i < FOCUS_ANIMATION_ACTOR_NUMBER; ++i )
+    {
+      mFocusEffect[i].animation.Play();
+    }
 
-  mAnimationTimer.SetInterval( BACKGROUND_ANIMATION_DURATION );
+    mPowerState = ACTIVE;
+  }
 }
 
 Dali::Actor DaliTableView::OnKeyboardPreFocusChange( Dali::Actor current, Dali::Actor proposed, Dali::Toolkit::Control::KeyboardFocus::Direction direction )
@@ -907,7 +1001,7 @@ Dali::Actor DaliTableView::OnKeyboardPreFocusChange( Dali::Actor current, Dali::
   if( !current && !proposed  )
   {
     // Set the initial focus to the first tile in the current page should be focused.
-    nextFocusActor = mPages[mScrollView.GetCurrentPage()].GetChildAt(0);
+    nextFocusActor = GetPage( mScrollView.GetCurrentPage() ).GetChildAt(0);
   }
   else if( !proposed )
   {
@@ -942,17 +1036,17 @@ Dali::Actor DaliTableView::OnKeyboardPreFocusChange( Dali::Actor current, Dali::
     if( direction == Dali::Toolkit::Control::KeyboardFocus::LEFT )
     {
       // Work out the cell position for the last tile
-      int remainingExamples = mExampleList.size() - newPage * EXAMPLES_PER_PAGE;
+      int remainingExamples = mCatalogue.GetCount() - newPage * EXAMPLES_PER_PAGE;
       int rowPos = (remainingExamples >= EXAMPLES_PER_PAGE) ? ROWS_PER_PAGE - 1 : ( (remainingExamples % EXAMPLES_PER_PAGE + EXAMPLES_PER_ROW) / EXAMPLES_PER_ROW - 1 );
       int colPos = remainingExamples >= EXAMPLES_PER_PAGE ? EXAMPLES_PER_ROW - 1 : ( remainingExamples % EXAMPLES_PER_PAGE - rowPos * EXAMPLES_PER_ROW - 1 );
 
       // Move the focus to the last tile in the new page.
-      nextFocusActor = mPages[newPage].GetChildAt(rowPos * EXAMPLES_PER_ROW + colPos);
+      nextFocusActor = GetPage( newPage ).GetChildAt(rowPos * EXAMPLES_PER_ROW + colPos);
     }
     else
     {
       // Move the focus to the first tile in the new page.
-      nextFocusActor = mPages[newPage].GetChildAt(0);
+      nextFocusActor = GetPage( newPage ).GetChildAt(0);
     }
   }
 
@@ -972,6 +1066,7 @@ void DaliTableView::OnFocusedActorActivated( Dali::Actor activatedActor )
 
 bool DaliTableView::OnTileHovered( Actor actor, const HoverEvent& event )
 {
+  OnActivity();
   KeyboardFocusManager::Get().SetCurrentFocusActor( actor );
   return true;
 }
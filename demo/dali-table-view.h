@@ -22,47 +22,12 @@
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali-toolkit/devel-api/controls/popup/popup.h>
 
-class Example;
-
-typedef std::vector<Example> ExampleList;
-typedef ExampleList::iterator ExampleListIter;
-typedef ExampleList::const_iterator ExampleListConstIter;
+class ExampleCatalogue;
 
 typedef std::vector<Dali::Animation> AnimationList;
 typedef AnimationList::iterator AnimationListIter;
 typedef AnimationList::const_iterator AnimationListConstIter;
 
-/**
- * Example information
- *
- * Represents a single Example.
- */
-struct Example
-{
-  // Constructors
-
-  /**
-   * @param[in] name unique name of example
-   * @param[in] title The caption for the example to appear on a tile button.
-   */
-  Example(std::string name, std::string title)
-  : name(name),
-    title(title)
-  {
-  }
-
-  Example()
-  {
-  }
-
-  // Data
-
-  std::string name;                       ///< unique name of example
-  std::string title;                      ///< title (caption) of example to appear on tile button.
-};
-
-
-
 /**
  * Dali-Demo instance
  */
@@ -70,34 +35,26 @@ class DaliTableView : public Dali::ConnectionTracker
 {
 public:
 
-  DaliTableView(Dali::Application& application);
-  ~DaliTableView();
-
-public:
-
-  /**
-   * Adds an Example to our demo showcase
-   *
-   * @param[in] example The Example description.
-   *
-   * @note Should be called before the Application MainLoop is started.
-   */
-  void AddExample(Example example);
-
   /**
-   * Sorts the example list alphabetically by Title if parameter is true.
-   *
-   * @param[in] sortAlphabetically If true, example list is sorted alphabetically.
-   *
-   * @note Should be called before the Application MainLoop is started.
-   * @note By default the examples are NOT sorted alphabetically by Title.
+   * @param[in] application The application
+   * @param[in] catalogue The examples to show, in order. Must outlive the DaliTableView.
    */
-  void SortAlphabetically( bool sortAlphabetically );
+  DaliTableView( Dali::Application& application, const ExampleCatalogue& catalogue );
+  ~DaliTableView();
 
 private: // Application callbacks & implementation
 
   static const unsigned int FOCUS_ANIMATION_ACTOR_NUMBER = 2; ///< The number of elements used to form the custom focus effect
 
+  /**
+   * Whether the launcher is animating, or idle and not rendering
+   */
+  enum PowerState
+  {
+    ACTIVE,
+    IDLE
+  };
+
   /**
    * Shape enum for create function
    */
@@ -116,11 +73,47 @@ private: // Application callbacks & implementation
 
   /**
    * Populates the contents (ScrollView) with all the
-   * Examples that have been Added using the AddExample(...)
-   * call
+   * Examples in the catalogue
+   *
+   * Only the first pages are created straight away, the others
+   * are created when the application is idle or scrolled to them.
    */
   void Populate();
 
+  /**
+   * Gets a page, creating it if it has not been created yet.
+   *
+   * @param[in] pageIndex The index of the page
+   *
+   * @return The page's TableView
+   */
+  Dali::Actor GetPage( int pageIndex );
+
+  /**
+   * Creates a page with its tiles and adds it to the ScrollView.
+   *
+   * @param[in] pageIndex The index of the page
+   */
+  void CreatePage( int pageIndex );
+
+  /**
+   * Creates a page and its neighbours if not yet created, and queues
+   * the creation of the remaining pages.
+   *
+   * @param[in] pageIndex The index of the page
+   */
+  void BuildPagesAround( int pageIndex );
+
+  /**
+   * Adds an idle callback to create the next page, if any are left to create.
+   */
+  void QueueIdlePageBuild();
+
+  /**
+   * Idle callback creating the page nearest the current page that has not been created yet.
+   */
+  void OnIdleBuildPage();
+
   /**
    * Rotate callback from the device.
    *
@@ -225,11 +218,6 @@ private: // Application callbacks & implementation
    */
   void ApplyScrollViewEffect();
 
-  /**
-   * Apply the cube effect to all the page actors
-   */
-  void ApplyCubeEffectToPages();
-
   /**
    * Setup the inner cube effect
    */
@@ -258,16 +246,16 @@ private: // Application callbacks & implementation
   void SetupBackground( Dali::Actor bubbleLayer );
 
   /**
-   * Create background actors for the given layer
+   * Create the bubbles for the given layer, drawn by a single renderer
    *
-   * @param[in] layer The layer to add the actors to
-   * @param[in] count The number of actors to generate
+   * @param[in] layer The layer to add the bubbles to
+   * @param[in] count The number of bubbles to generate
    * @param[in] distanceField A array (pointer) to 2 distance field types to use
    */
-  void AddBackgroundActors( Dali::Actor layer, int count, Dali::BufferImage* distanceField );
+  void AddBubbleField( Dali::Actor layer, int count, Dali::BufferImage* distanceField );
 
   /**
-   * Create a bitmap with the specified shape and also output a distance field
+   * Gets the distance field of the specified shape, from the on-disk cache if present
    *
    * @param[in] shapeType The shape to generate
    * @param[in] size The size of the bitmap to create
@@ -284,16 +272,6 @@ private: // Application callbacks & implementation
    */
   void GenerateSquare( const Dali::Size& size, std::vector<unsigned char>& distanceFieldOut );
 
-  /**
-   * Generate a circle bit pattern and depth field
-   *
-   * @param[in] size The size of the bitmap to create
-   * @param[out] imageOut The return bitmap
-   * @param[out] distanceFieldOut The return depth field alpha map
-   * @param[in] hollow Optional - Set to true for a thick circle outline without fill
-   */
-  void GenerateCircle( const Dali::Size& size, std::vector<unsigned char>& distanceFieldOut, bool hollow = false );
-
   /**
    * Creates the logo.
    *
@@ -304,21 +282,40 @@ private: // Application callbacks & implementation
   Dali::Toolkit::ImageView CreateLogo( std::string imagePath );
 
   /**
-   * Timer handler for ending background animation
+   * Timer handler for going idle after a period without input
    *
    * @return Return value for timer handler
    */
-  bool PauseBackgroundAnimation();
+  bool OnIdleTimer();
+
+  /**
+   * Signal emitted when the stage is touched
+   *
+   * @param[in] touch The touch information
+   */
+  void OnStageTouched( const Dali::TouchData& touch );
 
   /**
-   * Pause all animations
+   * Timer handler for reading the launch timing reported by the examples
+   *
+   * @return Whether to keep waiting for reports
    */
-  void PauseAnimation();
+  bool OnLaunchReportTimer();
 
   /**
-   * Resume all animations
+   * Called on any input: leaves the idle mode and restarts the countdown to it.
    */
-  void PlayAnimation();
+  void OnActivity();
+
+  /**
+   * Pauses all the looping animations, so nothing is updated or rendered until the next input.
+   */
+  void EnterIdleMode();
+
+  /**
+   * Resumes the looping animations.
+   */
+  void ExitIdleMode();
 
   /**
    * @brief Creates and sets up the custom effect used for the keyboard (and mouse) focus.
@@ -368,13 +365,6 @@ private: // Application callbacks & implementation
   */
  void OnStageConnect( Dali::Actor actor );
 
- /**
-  * @brief Callback called to set up background actors
-  *
-  * @param[in] actor The actor raising the callback
-  */
- void InitialiseBackgroundActors( Dali::Actor actor );
-
 private:
 
   Dali::Application&              mApplication;              ///< Application instance.
@@ -386,7 +376,8 @@ private:
   Dali::Toolkit::RulerPtr         mScrollRulerX;             ///< ScrollView X (horizontal) ruler
   Dali::Toolkit::RulerPtr         mScrollRulerY;             ///< ScrollView Y (vertical) ruler
   Dali::Actor                     mPressedActor;             ///< The currently pressed actor.
-  Dali::Timer                     mAnimationTimer;           ///< Timer used to turn off animation after a specific time period
+  Dali::Timer                     mIdleTimer;                ///< Timer used to go idle after a period without input
+  Dali::Timer                     mLaunchReportTimer;        ///< Timer used to poll for the launch timing of started examples
   Dali::TapGestureDetector        mLogoTapDetector;          ///< To detect taps on the logo
   Dali::Toolkit::Popup            mVersionPopup;             ///< Displays DALi library version information
 
@@ -400,16 +391,17 @@ private:
   };
   FocusEffect mFocusEffect[FOCUS_ANIMATION_ACTOR_NUMBER];    ///< The elements used to create the custom focus effect
 
-  std::vector< Dali::Actor >      mPages;                    ///< List of pages.
-  AnimationList                   mBackgroundAnimations;     ///< List of background bubble animations
-  ExampleList                     mExampleList;              ///< List of examples.
+  std::vector< Dali::Actor >      mPages;                    ///< List of pages, empty handles for pages not created yet.
+  AnimationList                   mBackgroundAnimations;     ///< List of background animations
+  const ExampleCatalogue&         mCatalogue;                ///< The examples, already sorted.
 
   float                           mPageWidth;                ///< The width of a page within the scroll-view, used to calculate the domain
   int                             mTotalPages;               ///< Total pages within scrollview.
+  unsigned long long              mPressTime;                ///< When the pressed tile was released, from ExampleLauncher::GetClock()
+  PowerState                      mPowerState;               ///< Whether the launcher is idle
 
   bool                            mScrolling:1;              ///< Flag indicating whether view is currently being scrolled
-  bool                            mSortAlphabetically:1;     ///< Sort examples alphabetically.
-  bool                            mBackgroundAnimsPlaying:1; ///< Are background animations playing
+  bool                            mPageBuildQueued:1;        ///< Whether an idle callback to create a page has been added
 
 };
 
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// CLASS HEADER
+#include "distance-field-cache.h"
+
+// EXTERNAL INCLUDES
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <dali/devel-api/adaptor-framework/event-thread-callback.h>
+
+// INTERNAL INCLUDES
+#include "shared/cache-directory.h"
+#include "shared/shape-distance-field.h"
+
+using namespace Dali;
+
+namespace
+{
+
+const unsigned int CACHE_VERSION = 2u; ///< Part of the file names; change it when the shapes or how they are generated change
+
+const char* const SHAPE_NAMES[] = { "circle", "bubble", "rounded-rect", "star" };
+const DemoHelper::Shape::Type SHAPE_TYPES[] = { DemoHelper::Shape::CIRCLE, DemoHelper::Shape::RING, DemoHelper::Shape::ROUNDED_RECT, DemoHelper::Shape::STAR };
+
+/**
+ * A distance field being generated on a worker thread.
+ */
+struct Job
+{
+  DistanceFieldCache::Shape  mShape;
+  unsigned int               mSize;
+  float                      mSpread;
+  std::string                mPath;          ///< Where to cache it, empty if there is no cache directory
+  std::vector<unsigned char> mDistanceField; ///< Written by the worker
+  BufferImage                mImage;         ///< Only used on the event thread
+};
+
+pthread_mutex_t            gMutex = PTHREAD_MUTEX_INITIALIZER; ///< Guards gFinishedJobs
+std::vector<Job*>          gFinishedJobs;
+EventThreadCallback*       gEventTrigger = NULL;               ///< Wakes the event thread when jobs are finished
+
+std::string GetCachePath( DistanceFieldCache::Shape shape, unsigned int size, float spread )
+{
+  const std::string directory = DemoHelper::GetCacheDirectory();
+  if( directory.empty() )
+  {
+    return directory;
+  }
+
+  std::ostringstream path;
+  path << directory << "/distance-field-" << SHAPE_NAMES[ shape ] << "-" << size << "-" << spread << "-v" << CACHE_VERSION << ".a8";
+  return path.str();
+}
+
+/**
+ * Maps a cache file privately, so the image can treat it as its own buffer.
+ *
+ * @return The mapped data, or NULL if the file is missing or not @p length bytes long.
+ */
+unsigned char* MapCacheFile( const std::string& path, size_t length )
+{
+  int file = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+  if( file < 0 )
+  {
+    return NULL;
+  }
+
+  void* data = MAP_FAILED;
+  struct stat status;
+  if( fstat( file, &status ) == 0 && status.st_size == static_cast<off_t>( length ) )
+  {
+    data = mmap( NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0 );
+  }
+  close( file );
+
+  return data != MAP_FAILED ? static_cast<unsigned char*>( data ) : NULL;
+}
+
+/**
+ * Writes a cache file. It is written under a temporary name first, so other
+ * processes never map a partially written file.
+ */
+void WriteCacheFile( const std::string& path, const std::vector<unsigned char>& data )
+{
+  std::ostringstream temporaryPath;
+  temporaryPath << path << "." << getpid() << ".tmp";
+
+  FILE* file = fopen( temporaryPath.str().c_str(), "wb" );
+  if( !file )
+  {
+    return;
+  }
+
+  const bool written = fwrite( &data[0], 1, data.size(), file ) == data.size();
+  if( fclose( file ) == 0 && written )
+  {
+    rename( temporaryPath.str().c_str(), path.c_str() );
+  }
+  else
+  {
+    unlink( temporaryPath.str().c_str() );
+  }
+}
+
+/**
+ * Generates and caches the distance field of a job. Runs on a worker thread.
+ */
+void* GenerateInBackground( void* data )
+{
+  Job* job = static_cast<Job*>( data );
+  DemoHelper::GenerateShapeDistanceField( SHAPE_TYPES[ job->mShape ], job->mSize, job->mSpread, job->mDistanceField );
+  if( !job->mPath.empty() )
+  {
+    WriteCacheFile( job->mPath, job->mDistanceField );
+  }
+
+  pthread_mutex_lock( &gMutex );
+  gFinishedJobs.push_back( job );
+  pthread_mutex_unlock( &gMutex );
+
+  gEventTrigger->Trigger();
+  return NULL;
+}
+
+/**
+ * Fills in the images of the finished jobs. Called on the event thread.
+ */
+void OnJobsFinished()
+{
+  std::vector<Job*> finishedJobs;
+  pthread_mutex_lock( &gMutex );
+  finishedJobs.swap( gFinishedJobs );
+  pthread_mutex_unlock( &gMutex );
+
+  for( std::vector<Job*>::iterator iter = finishedJobs.begin(); iter != finishedJobs.end(); ++iter )
+  {
+    Job* job = *iter;
+    memcpy( job->mImage.GetBuffer(), &job->mDistanceField[0], job->mDistanceField.size() );
+    job->mImage.Update();
+    delete job;
+  }
+}
+
+} // namespace
+
+namespace DistanceFieldCache
+{
+
+BufferImage Load( Shape shape, unsigned int size, float spread )
+{
+  const size_t length = size * size;
+  const std::string path = GetCachePath( shape, size, spread );
+  if( !path.empty() )
+  {
+    // The mapping is used as the image's buffer, so is kept for the lifetime of the process.
+    unsigned char* distanceField = MapCacheFile( path, length );
+    if( distanceField )
+    {
+      return BufferImage::New( distanceField, size, size, Pixel::A8 );
+    }
+  }
+
+  BufferImage image = BufferImage::New( size, size, Pixel::A8 );
+  memset( image.GetBuffer(), 0, length );
+
+  Job* job = new Job;
+  job->mShape = shape;
+  job->mSize = size;
+  job->mSpread = spread;
+  job->mPath = path;
+  job->mImage = image;
+
+  if( !gEventTrigger )
+  {
+    gEventTrigger = new EventThreadCallback( MakeCallback( &OnJobsFinished ) );
+  }
+
+  pthread_t thread;
+  if( pthread_create( &thread, NULL, &GenerateInBackground, job ) == 0 )
+  {
+    pthread_detach( thread );
+  }
+  else
+  {
+    DemoHelper::GenerateShapeDistanceField( SHAPE_TYPES[ shape ], size, spread, job->mDistanceField );
+    memcpy( image.GetBuffer(), &job->mDistanceField[0], length );
+    if( !path.empty() )
+    {
+      WriteCacheFile( path, job->mDistanceField );
+    }
+    delete job;
+  }
+
+  return image;
+}
+
+} // namespace DistanceFieldCache
@@ -0,0 +1,56 @@
+#ifndef DALI_DEMO_DISTANCE_FIELD_CACHE_H
+#define DALI_DEMO_DISTANCE_FIELD_CACHE_H
+
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <dali/dali.h>
+
+/**
+ * On-disk cache of the distance fields of the launcher's background shapes.
+ *
+ * The distance fields are stored as raw A8 files in $XDG_CACHE_HOME/dali-demo (or
+ * ~/.cache/dali-demo), named after the shape, size and spread they were generated with.
+ * A cached distance field is memory mapped and used in place. When it is missing, a blank
+ * image is returned straight away and the distance field is generated on a worker thread;
+ * the image is filled in once it is ready and the file written for the next start.
+ */
+namespace DistanceFieldCache
+{
+
+enum Shape
+{
+  CIRCLE,
+  BUBBLE,
+  ROUNDED_RECT,
+  STAR
+};
+
+/**
+ * Returns the distance field of a shape, from the cache if present.
+ *
+ * @param[in] shape The shape
+ * @param[in] size The width and height of the distance field, in pixels
+ * @param[in] spread The distance, in pixels, over which the field goes from inside to outside
+ *
+ * @return An A8 image of the distance field, blank until generated if it was not cached.
+ */
+Dali::BufferImage Load( Shape shape, unsigned int size, float spread );
+
+} // namespace DistanceFieldCache
+
+#endif // DALI_DEMO_DISTANCE_FIELD_CACHE_H
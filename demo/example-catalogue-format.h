@@ -0,0 +1,59 @@
+#ifndef DALI_DEMO_EXAMPLE_CATALOGUE_FORMAT_H
+#define DALI_DEMO_EXAMPLE_CATALOGUE_FORMAT_H
+
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <stdint.h>
+
+/**
+ * The layout of a compiled example catalogue, shared by the catalogue compiler and the launcher.
+ *
+ * A catalogue is a Header, followed by Header::count Entry structures already in the order the
+ * launcher shows them, followed by a table of nul-terminated strings. The entries refer to their
+ * strings by offset from the start of the file. Values are in the byte order of the machine the
+ * catalogue was compiled on; the launcher rejects a catalogue whose magic number does not match.
+ */
+namespace ExampleCatalogueFormat
+{
+
+const uint32_t MAGIC = 0x54414344;  ///< "DCAT" when read in little endian byte order
+const uint32_t VERSION = 1u;         ///< Change it when the layout changes
+
+struct Header
+{
+  uint32_t magic;              ///< MAGIC
+  uint32_t version;            ///< VERSION
+  uint32_t count;              ///< The number of entries
+  uint32_t stringTableOffset;  ///< Where the strings start
+  uint32_t size;               ///< The size of the whole file
+};
+
+struct Entry
+{
+  uint32_t name;               ///< The example binary
+  uint32_t titleId;            ///< The message id of the title, an empty string if not translated
+  uint32_t title;              ///< The untranslated title
+  uint32_t icon;               ///< The tile image, an empty string if none
+  uint32_t tags;               ///< Comma separated keywords
+  int32_t  weight;             ///< What the entries were sorted by, before their titles
+};
+
+} // namespace ExampleCatalogueFormat
+
+#endif // DALI_DEMO_EXAMPLE_CATALOGUE_FORMAT_H
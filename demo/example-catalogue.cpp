@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// CLASS HEADER
+#include "example-catalogue.h"
+
+// EXTERNAL INCLUDES
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// INTERNAL INCLUDES
+#include "shared/dali-demo-strings.h"
+
+using namespace ExampleCatalogueFormat;
+
+ExampleCatalogue::ExampleCatalogue()
+: mData( NULL ),
+  mSize( 0u ),
+  mHeader( NULL ),
+  mEntries( NULL )
+{
+}
+
+ExampleCatalogue::~ExampleCatalogue()
+{
+  if( mData )
+  {
+    munmap( const_cast<char*>( mData ), mSize );
+  }
+}
+
+bool ExampleCatalogue::Load( const std::string& path )
+{
+  int file = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+  if( file < 0 )
+  {
+    return false;
+  }
+
+  void* data = MAP_FAILED;
+  struct stat status;
+  if( fstat( file, &status ) == 0 && static_cast<size_t>( status.st_size ) >= sizeof( Header ) )
+  {
+    data = mmap( NULL, status.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+  }
+  close( file );
+
+  if( data == MAP_FAILED )
+  {
+    return false;
+  }
+
+  const size_t size = status.st_size;
+  const Header* header = static_cast<const Header*>( data );
+  const char* strings = static_cast<const char*>( data ) + header->stringTableOffset;
+
+  // Check the layout once, so the accessors can trust the offsets
+  bool valid = header->magic == MAGIC &&
+               header->version == VERSION &&
+               header->size == size &&
+               header->stringTableOffset < size &&
+               header->stringTableOffset >= sizeof( Header ) + static_cast<size_t>( header->count ) * sizeof( Entry ) &&
+               strings[ size - header->stringTableOffset - 1 ] == '\0';
+
+  const Entry* entries = reinterpret_cast<const Entry*>( header + 1 );
+  for( uint32_t i = 0; valid && i < header->count; ++i )
+  {
+    const Entry& entry = entries[i];
+    const uint32_t offsets[] = { entry.name, entry.titleId, entry.title, entry.icon, entry.tags };
+    for( unsigned int j = 0; j < sizeof( offsets ) / sizeof( offsets[0] ); ++j )
+    {
+      valid = valid && offsets[j] >= header->stringTableOffset && offsets[j] < size;
+    }
+  }
+
+  if( !valid )
+  {
+    munmap( data, size );
+    return false;
+  }
+
+  if( mData )
+  {
+    munmap( const_cast<char*>( mData ), mSize );
+  }
+  mData = static_cast<const char*>( data );
+  mSize = size;
+  mHeader = header;
+  mEntries = entries;
+  return true;
+}
+
+unsigned int ExampleCatalogue::GetCount() const
+{
+  return mHeader ? mHeader->count : 0u;
+}
+
+const char* ExampleCatalogue::GetName( unsigned int index ) const
+{
+  return GetString( mEntries[ index ].name );
+}
+
+const char* ExampleCatalogue::GetTitle( unsigned int index ) const
+{
+#ifdef INTERNATIONALIZATION_ENABLED
+  // dgettext() returns the message id itself when there is no translation
+  const char* titleId = GetString( mEntries[ index ].titleId );
+  if( *titleId )
+  {
+    const char* title = dgettext( DALI_DEMO_DOMAIN_LOCAL, titleId );
+    if( title != titleId )
+    {
+      return title;
+    }
+  }
+#endif
+
+  return GetString( mEntries[ index ].title );
+}
+
+const char* ExampleCatalogue::GetIcon( unsigned int index ) const
+{
+  return GetString( mEntries[ index ].icon );
+}
+
+const char* ExampleCatalogue::GetTags( unsigned int index ) const
+{
+  return GetString( mEntries[ index ].tags );
+}
+
+int ExampleCatalogue::Find( const std::string& name ) const
+{
+  for( unsigned int i = 0, count = GetCount(); i < count; ++i )
+  {
+    if( name == GetName( i ) )
+    {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+const char* ExampleCatalogue::GetString( uint32_t offset ) const
+{
+  return mData + offset;
+}
@@ -0,0 +1,98 @@
+#ifndef DALI_DEMO_EXAMPLE_CATALOGUE_H
+#define DALI_DEMO_EXAMPLE_CATALOGUE_H
+
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <cstddef>
+#include <string>
+
+// INTERNAL INCLUDES
+#include "example-catalogue-format.h"
+
+/**
+ * The examples shown by the launcher, read from a compiled catalogue.
+ *
+ * The catalogue is compiled from a manifest at build time (see resources/catalogues), already
+ * sorted, so it is memory mapped and used in place: loading it copies no strings and sorts nothing.
+ */
+class ExampleCatalogue
+{
+public:
+
+  ExampleCatalogue();
+  ~ExampleCatalogue();
+
+  /**
+   * Maps a compiled catalogue.
+   *
+   * @param[in] path The catalogue file
+   *
+   * @return false if the file cannot be read or is not a valid catalogue.
+   */
+  bool Load( const std::string& path );
+
+  /**
+   * The number of examples.
+   */
+  unsigned int GetCount() const;
+
+  /**
+   * The name of the example binary.
+   */
+  const char* GetName( unsigned int index ) const;
+
+  /**
+   * The title of the example, translated if a translation is available.
+   */
+  const char* GetTitle( unsigned int index ) const;
+
+  /**
+   * The tile image of the example, an empty string if none.
+   */
+  const char* GetIcon( unsigned int index ) const;
+
+  /**
+   * The comma separated tags of the example.
+   */
+  const char* GetTags( unsigned int index ) const;
+
+  /**
+   * Finds an example by the name of its binary.
+   *
+   * @return The index of the example, or -1 if not in the catalogue.
+   */
+  int Find( const std::string& name ) const;
+
+private:
+
+  // Undefined
+  ExampleCatalogue( const ExampleCatalogue& );
+  ExampleCatalogue& operator=( const ExampleCatalogue& );
+
+  const char* GetString( uint32_t offset ) const;
+
+private:
+
+  const char*                            mData;     ///< The mapped file
+  size_t                                 mSize;
+  const ExampleCatalogueFormat::Header*  mHeader;
+  const ExampleCatalogueFormat::Entry*   mEntries;
+};
+
+#endif // DALI_DEMO_EXAMPLE_CATALOGUE_H
@@ -0,0 +1,485 @@
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// CLASS HEADER
+#include "example-launcher.h"
+
+// EXTERNAL INCLUDES
+#include <dali/dali.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <vector>
+#include <unistd.h>
+#ifdef ZYGOTE_ENABLED
+#include <dirent.h>
+#include <dlfcn.h>
+#include <signal.h>
+#include <sys/socket.h>
+#endif
+
+// INTERNAL INCLUDES
+#include "shared/launch-timing.h"
+
+namespace
+{
+
+const unsigned long long LAUNCH_REPORT_TIMEOUT = 30000000ull; ///< Microseconds after the last launch to stop waiting for reports
+
+/**
+ * Launch timings of an example, in milliseconds since its tile was pressed.
+ */
+struct LaunchTimes
+{
+  LaunchTimes()
+  : mCount( 0u ),
+    mTotalInit( 0.0 ),
+    mTotalFirstFrame( 0.0 ),
+    mMinFirstFrame( 0.0 ),
+    mMaxFirstFrame( 0.0 )
+  {
+  }
+
+  unsigned int mCount;
+  double       mTotalInit;
+  double       mTotalFirstFrame;
+  double       mMinFirstFrame;
+  double       mMaxFirstFrame;
+};
+
+typedef std::map<std::string, LaunchTimes> LaunchTimesMap;
+
+int                gReportPipe[2] = { -1, -1 }; ///< The examples write their launch timing to the write end
+LaunchTimesMap     gLaunchTimes;
+std::string        gPartialReport;              ///< The start of a report line not completely read yet
+unsigned int       gPendingReports = 0u;        ///< Launches not reported yet
+unsigned long long gLastLaunchTime = 0u;        ///< From GetLaunchClock()
+
+const unsigned int LAUNCH_VARIABLE_COUNT = 3u;
+const char* const LAUNCH_VARIABLE_NAMES[ LAUNCH_VARIABLE_COUNT ] =
+{
+  DemoHelper::LAUNCH_NAME_ENV,
+  DemoHelper::LAUNCH_TIME_ENV,
+  DemoHelper::LAUNCH_REPORT_FD_ENV
+};
+
+/**
+ * Formats the values of the variables that tell the example about its launch, in the order of LAUNCH_VARIABLE_NAMES.
+ *
+ * @return false if launches are not being timed.
+ */
+bool GetLaunchVariables( const std::string& name, unsigned long long launchTime, std::string values[ LAUNCH_VARIABLE_COUNT ] )
+{
+  if( gReportPipe[1] < 0 )
+  {
+    return false;
+  }
+
+  std::ostringstream time;
+  time << launchTime;
+  std::ostringstream reportFd;
+  reportFd << gReportPipe[1];
+
+  values[0] = name;
+  values[1] = time.str();
+  values[2] = reportFd.str();
+  return true;
+}
+
+#ifdef ZYGOTE_ENABLED
+/**
+ * Tells the example about its launch, through the environment of this process.
+ */
+void SetLaunchEnvironment( const std::string& name, unsigned long long launchTime )
+{
+  std::string values[ LAUNCH_VARIABLE_COUNT ];
+  if( GetLaunchVariables( name, launchTime, values ) )
+  {
+    for( unsigned int i = 0u; i < LAUNCH_VARIABLE_COUNT; ++i )
+    {
+      setenv( LAUNCH_VARIABLE_NAMES[i], values[i].c_str(), 1 );
+    }
+  }
+}
+#endif
+
+/**
+ * An environment for exec: the environment of this process with the launch variables added,
+ * prepared before forking so the child does not need to allocate.
+ */
+class LaunchEnvironment
+{
+public:
+
+  LaunchEnvironment( const std::string& name, unsigned long long launchTime )
+  {
+    std::string values[ LAUNCH_VARIABLE_COUNT ];
+    const bool timed = GetLaunchVariables( name, launchTime, values );
+
+    for( char** variable = environ; *variable; ++variable )
+    {
+      if( !timed || !IsLaunchVariable( *variable ) )
+      {
+        mPointers.push_back( *variable );
+      }
+    }
+
+    if( timed )
+    {
+      for( unsigned int i = 0u; i < LAUNCH_VARIABLE_COUNT; ++i )
+      {
+        mVariables.push_back( std::string( LAUNCH_VARIABLE_NAMES[i] ) + "=" + values[i] );
+      }
+      for( std::vector<std::string>::iterator iter = mVariables.begin(); iter != mVariables.end(); ++iter )
+      {
+        mPointers.push_back( &(*iter)[0] );
+      }
+    }
+    mPointers.push_back( NULL );
+  }
+
+  char* const* Get() const
+  {
+    return &mPointers[0];
+  }
+
+private:
+
+  static bool IsLaunchVariable( const char* variable )
+  {
+    for( unsigned int i = 0u; i < LAUNCH_VARIABLE_COUNT; ++i )
+    {
+      const size_t length = strlen( LAUNCH_VARIABLE_NAMES[i] );
+      if( strncmp( variable, LAUNCH_VARIABLE_NAMES[i], length ) == 0 && variable[ length ] == '=' )
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::vector<std::string> mVariables; ///< The launch variables, as "NAME=VALUE"
+  std::vector<char*>       mPointers;  ///< The NULL terminated environment
+};
+
+/**
+ * The path of an example binary.
+ */
+std::string GetExamplePath( const std::string& name )
+{
+  return std::string( DEMO_EXAMPLE_BIN ) + name;
+}
+
+/**
+ * Replaces the current process with the example binary.
+ *
+ * @note Does not allocate, so it is safe to call in the child of a multithreaded process;
+ * the path and environment must be worked out before the fork.
+ */
+void ExecExample( const char* path, const char* name, char* const* environment )
+{
+  char* const argv[] = { const_cast<char*>( name ), NULL };
+  execve( path, argv, environment );
+
+  const char message[] = "exec failed!\n";
+  ssize_t written = write( STDERR_FILENO, message, sizeof( message ) - 1 );
+  (void)written;
+  _exit( EXIT_FAILURE );
+}
+
+#ifdef ZYGOTE_ENABLED
+
+int gZygoteSocket = -1; ///< The launcher's end of the socket to the zygote, -1 when there is no zygote
+
+/**
+ * Runs the main() of the example's shared object and exits with its result.
+ * Falls back to the example binary if there is no shared object.
+ */
+void RunExampleModule( const std::string& name )
+{
+  const std::string binaryPath = GetExamplePath( name );
+  const std::string path = binaryPath + ".so";
+  void* module = dlopen( path.c_str(), RTLD_NOW | RTLD_LOCAL );
+  if( !module )
+  {
+    std::cerr << "Unable to load " << path << ": " << dlerror() << std::endl;
+    ExecExample( binaryPath.c_str(), name.c_str(), environ );
+  }
+
+  typedef int (*MainFunction)( int, char** );
+  MainFunction exampleMain = reinterpret_cast<MainFunction>( dlsym( module, "main" ) );
+  if( !exampleMain )
+  {
+    std::cerr << "No main() in " << path << std::endl;
+    ExecExample( binaryPath.c_str(), name.c_str(), environ );
+  }
+
+  std::vector<char> programName( name.begin(), name.end() );
+  programName.push_back( '\0' );
+  char* argv[] = { &programName[0], NULL };
+  exit( exampleMain( 1, argv ) );
+}
+
+/**
+ * Reads the theme and style files, so the examples find them in the page cache.
+ *
+ * The parsed theme cannot be handed to the examples, as each example's toolkit parses
+ * it again when its adaptor starts, which cannot be done before the fork.
+ */
+void WarmStyleFiles()
+{
+  std::vector<std::string> paths;
+  if( DIR* directory = opendir( DEMO_STYLE_DIR ) )
+  {
+    while( dirent* entry = readdir( directory ) )
+    {
+      const std::string name( entry->d_name );
+      const size_t extension = name.rfind( '.' );
+      if( extension != std::string::npos && name.substr( extension + 1 ) == "json" )
+      {
+        paths.push_back( std::string( DEMO_STYLE_DIR ) + name );
+      }
+    }
+    closedir( directory );
+  }
+
+  char buffer[4096];
+  for( std::vector<std::string>::const_iterator iter = paths.begin(); iter != paths.end(); ++iter )
+  {
+    const int file = open( iter->c_str(), O_RDONLY | O_CLOEXEC );
+    if( file >= 0 )
+    {
+      while( read( file, buffer, sizeof( buffer ) ) > 0 )
+      {
+      }
+      close( file );
+    }
+  }
+}
+
+/**
+ * The zygote: forks an example for every "name launch_time" line received on the socket,
+ * until the launcher closes it.
+ */
+void RunZygote( int socket )
+{
+  // The examples are reaped automatically
+  signal( SIGCHLD, SIG_IGN );
+
+  WarmStyleFiles();
+
+  std::string received;
+  char buffer[256];
+  ssize_t length;
+  while( ( length = read( socket, buffer, sizeof( buffer ) ) ) > 0 )
+  {
+    received.append( buffer, length );
+
+    size_t end;
+    while( ( end = received.find( '\n' ) ) != std::string::npos )
+    {
+      std::istringstream request( received.substr( 0, end ) );
+      received.erase( 0, end + 1 );
+
+      std::string name;
+      unsigned long long launchTime = 0u;
+      request >> name >> launchTime;
+
+      if( fork() == 0 )
+      {
+        close( socket );
+        signal( SIGCHLD, SIG_DFL );
+        SetLaunchEnvironment( name, launchTime );
+        RunExampleModule( name );
+      }
+    }
+  }
+
+  _exit( EXIT_SUCCESS );
+}
+
+#endif // ZYGOTE_ENABLED
+
+} // namespace
+
+namespace ExampleLauncher
+{
+
+void Initialize()
+{
+  // The read end is only for the launcher; the write end is inherited by the examples
+  if( pipe( gReportPipe ) == 0 )
+  {
+    fcntl( gReportPipe[0], F_SETFD, FD_CLOEXEC );
+    fcntl( gReportPipe[0], F_SETFL, O_NONBLOCK );
+  }
+  else
+  {
+    std::cerr << "Unable to create the launch report pipe, launch times will not be measured" << std::endl;
+    gReportPipe[0] = gReportPipe[1] = -1;
+  }
+
+#ifdef ZYGOTE_ENABLED
+  int sockets[2];
+  if( socketpair( AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sockets ) != 0 )
+  {
+    std::cerr << "Unable to create the zygote socket, examples will be started from their binaries" << std::endl;
+    return;
+  }
+
+  pid_t pid = fork();
+  if( pid == 0 )
+  {
+    close( sockets[0] );
+    if( gReportPipe[0] >= 0 )
+    {
+      close( gReportPipe[0] );
+    }
+    RunZygote( sockets[1] );
+  }
+
+  close( sockets[1] );
+  if( pid > 0 )
+  {
+    gZygoteSocket = sockets[0];
+  }
+  else
+  {
+    close( sockets[0] );
+  }
+#endif
+}
+
+unsigned long long GetClock()
+{
+  return DemoHelper::GetLaunchClock();
+}
+
+void Launch( const std::string& name, unsigned long long pressTime )
+{
+  ++gPendingReports;
+  gLastLaunchTime = GetClock();
+
+#ifdef ZYGOTE_ENABLED
+  if( gZygoteSocket >= 0 )
+  {
+    std::ostringstream request;
+    request << name << " " << pressTime << "\n";
+    const std::string requestString = request.str();
+    if( send( gZygoteSocket, requestString.c_str(), requestString.size(), MSG_NOSIGNAL ) == static_cast<ssize_t>( requestString.size() ) )
+    {
+      return;
+    }
+
+    // The zygote has gone, start the binaries from now on
+    close( gZygoteSocket );
+    gZygoteSocket = -1;
+  }
+#endif
+
+  const std::string path = GetExamplePath( name );
+  const LaunchEnvironment environment( name, pressTime );
+  pid_t pid = fork();
+  if( pid == 0 )
+  {
+    ExecExample( path.c_str(), name.c_str(), environment.Get() );
+  }
+}
+
+bool ReadLaunchReports()
+{
+  if( gReportPipe[0] < 0 )
+  {
+    return false;
+  }
+
+  char buffer[512];
+  ssize_t length;
+  while( ( length = read( gReportPipe[0], buffer, sizeof( buffer ) ) ) > 0 )
+  {
+    gPartialReport.append( buffer, length );
+  }
+
+  bool updated = false;
+  size_t end;
+  while( ( end = gPartialReport.find( '\n' ) ) != std::string::npos )
+  {
+    std::string line = gPartialReport.substr( 0, end );
+    gPartialReport.erase( 0, end + 1 );
+
+    size_t firstComma = line.find( ',' );
+    size_t secondComma = line.find( ',', firstComma + 1 );
+    if( firstComma == std::string::npos || secondComma == std::string::npos )
+    {
+      continue;
+    }
+
+    const double init = atof( line.substr( firstComma + 1, secondComma - firstComma - 1 ).c_str() );
+    const double firstFrame = atof( line.substr( secondComma + 1 ).c_str() );
+
+    LaunchTimes& times = gLaunchTimes[ line.substr( 0, firstComma ) ];
+    times.mMinFirstFrame = times.mCount == 0u ? firstFrame : std::min( times.mMinFirstFrame, firstFrame );
+    times.mMaxFirstFrame = times.mCount == 0u ? firstFrame : std::max( times.mMaxFirstFrame, firstFrame );
+    times.mTotalInit += init;
+    times.mTotalFirstFrame += firstFrame;
+    ++times.mCount;
+
+    gPendingReports = gPendingReports > 0u ? gPendingReports - 1u : 0u;
+    updated = true;
+  }
+
+  return updated;
+}
+
+bool IsWaitingForReports()
+{
+  return gPendingReports > 0u && GetClock() - gLastLaunchTime < LAUNCH_REPORT_TIMEOUT;
+}
+
+void PrintLaunchTimes( std::ostream& stream )
+{
+  stream << std::left << std::setw( 40 ) << "example"
+         << std::right << std::setw( 8 ) << "launches"
+         << std::setw( 12 ) << "init_ms"
+         << std::setw( 16 ) << "first_frame_ms"
+         << std::setw( 10 ) << "min_ms"
+         << std::setw( 10 ) << "max_ms" << "\n";
+
+  const std::ios::fmtflags flags = stream.flags();
+  const std::streamsize precision = stream.precision();
+  stream << std::fixed << std::setprecision( 1 );
+  for( LaunchTimesMap::const_iterator iter = gLaunchTimes.begin(); iter != gLaunchTimes.end(); ++iter )
+  {
+    const LaunchTimes& times = iter->second;
+    stream << std::left << std::setw( 40 ) << iter->first
+           << std::right << std::setw( 8 ) << times.mCount
+           << std::setw( 12 ) << times.mTotalInit / times.mCount
+           << std::setw( 16 ) << times.mTotalFirstFrame / times.mCount
+           << std::setw( 10 ) << times.mMinFirstFrame
+           << std::setw( 10 ) << times.mMaxFirstFrame << "\n";
+  }
+  stream.flags( flags );
+  stream.precision( precision );
+  stream.flush();
+}
+
+} // namespace ExampleLauncher
@@ -0,0 +1,83 @@
+#ifndef DALI_DEMO_EXAMPLE_LAUNCHER_H
+#define DALI_DEMO_EXAMPLE_LAUNCHER_H
+
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <ostream>
+#include <string>
+
+/**
+ * Starts the examples in their own processes.
+ *
+ * When built with ZYGOTE_ENABLED (off by default), the launcher forks a zygote before
+ * creating its Application. The zygote has the DALi libraries loaded and relocated, reads
+ * the theme and style files into the page cache, and waits for example names on a socket;
+ * for each one it forks again and runs the example's main() from its shared object
+ * ("<name>.so"), skipping the exec and dynamic linking of a fresh process. The adaptor,
+ * GL context and parsed theme cannot be shared across a fork, so each example still
+ * creates its own.
+ *
+ * Without a zygote, or if the example has no shared object, the example binary is
+ * started with fork() and exec().
+ *
+ * The examples report how long they took from the press of their tile to initialise and to
+ * render their first frame (see shared/launch-timing.h); the launcher keeps the averages.
+ */
+namespace ExampleLauncher
+{
+
+/**
+ * Creates the pipe the examples report their launch timing to, and forks the zygote.
+ *
+ * @note Must be called before the Application is created, while the process is single threaded.
+ */
+void Initialize();
+
+/**
+ * The clock launch times are measured with, in microseconds.
+ */
+unsigned long long GetClock();
+
+/**
+ * Starts an example.
+ *
+ * @param[in] name The name of the example binary, e.g. "blocks.example".
+ * @param[in] pressTime When its tile was pressed, from GetClock().
+ */
+void Launch( const std::string& name, unsigned long long pressTime );
+
+/**
+ * Reads the launch timing reported by the examples since the last call.
+ *
+ * @return true if any example reported.
+ */
+bool ReadLaunchReports();
+
+/**
+ * Whether examples that were launched recently have yet to report.
+ */
+bool IsWaitingForReports();
+
+/**
+ * Prints the average launch timing of each example.
+ */
+void PrintLaunchTimes( std::ostream& stream );
+
+} // namespace ExampleLauncher
+
+#endif // DALI_DEMO_EXAMPLE_LAUNCHER_H
@@ -18,6 +18,7 @@
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
 #include "shared/view.h"
+#include "shared/launch-timing.h"
 
 #include <sstream>
 
@@ -466,9 +467,10 @@ void RunTest( Application& application )
   application.MainLoop();
 }
 
-int main( int argc, char **argv )
+int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv );
+  DemoHelper::ReportLaunchTiming( application );
   RunTest( application );
 
   return 0;
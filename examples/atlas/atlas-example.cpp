@@ -19,6 +19,7 @@
 #include <dali/devel-api/images/atlas.h>
 
 #include "shared/view.h"
+#include "shared/launch-timing.h"
 #include <iostream>
 #include <cstdio>
 
@@ -237,6 +238,7 @@ void RunTest( Application& application )
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   gApplication = Application::New( &argc, &argv, DEMO_THEME_PATH );
+  DemoHelper::ReportLaunchTiming( gApplication );
 
   RunTest( gApplication );
 
@@ -21,6 +21,10 @@
 
 // INTERNAL INCLUDES
 #include "shared/utility.h"
+#include "shared/frame-timing-recorder.h"
+#include "shared/headless.h"
+#include "shared/benchmark-compare.h"
+#include "shared/launch-timing.h"
 
 using namespace Dali;
 using namespace Dali::Toolkit;
@@ -188,6 +192,21 @@ bool gNinePatch(false);
 unsigned int gRowsPerPage(25);
 unsigned int gColumnsPerPage( 25 );
 unsigned int gPageCount(13);
+std::string gReportPath;
+bool gHeadless(false);
+unsigned int gFrameStep(16);
+std::string gSweep;
+std::string gFrameTimesPath;
+std::string gBaselinePath;
+std::string gSaveBaselinePath;
+DemoHelper::RegressionOptions gRegressionOptions;
+
+const DemoHelper::SweepOption SWEEP_OPTIONS[] = {
+                                                  { "rows", "-r" },
+                                                  { "columns", "-c" },
+                                                  { "pages", "-p" },
+};
+const unsigned int NUM_SWEEP_OPTIONS = sizeof(SWEEP_OPTIONS) / sizeof(SWEEP_OPTIONS[0]);
 
 Renderer CreateRenderer( unsigned int index, Geometry geometry, Shader shader )
 {
@@ -209,6 +228,15 @@ Renderer CreateRenderer( unsigned int index, Geometry geometry, Shader shader )
 // -p NumberOfPages (Modifies the nimber of pages )
 // --use-mesh ( Use new renderer API (as ImageView) but shares renderers between actors when possible )
 // --nine-patch ( Use nine patch images )
+// --headless ( Renders offscreen, ignores touch and advances the animations by a fixed step per rendered frame )
+// --frame-step=Milliseconds ( The fixed step used by --headless, 16ms by default )
+// --sweep=Specification ( Runs every combination of e.g. "rows=5..50:5,pages=1..20" in a fresh process and writes a scaling table to the report instead )
+// --frame-times=FileName ( Writes the duration of every frame to FileName )
+// --save-baseline=FileName ( Runs the test --runs times in fresh processes and saves the pooled frame times as a baseline )
+// --baseline=FileName ( Runs the test --runs times in fresh processes and fails if it is significantly slower than the baseline )
+// --runs=N ( Number of runs for --save-baseline and --baseline, 5 by default )
+// --max-regression=Percent ( Allowed growth of the p95 frame time for --baseline, 5% by default )
+// --report=FileName ( Writes the frame timing report to FileName, as CSV if it ends in ".csv" and JSON otherwise. Defaults to the standard output )
 
 //
 class Benchmark : public ConnectionTracker
@@ -242,8 +270,18 @@ public:
 
     mSize = Vector3( stageSize.x / mColumnsPerPage, stageSize.y / mRowsPerPage, 0.0f );
 
-    // Respond to a click anywhere on the stage
-    stage.GetRootLayer().TouchSignal().Connect( this, &Benchmark::OnTouch );
+    if( gHeadless )
+    {
+      DemoHelper::RenderOffscreen();
+      mClock.Enable( gFrameStep );
+    }
+    else
+    {
+      // Respond to a click anywhere on the stage
+      stage.GetRootLayer().TouchSignal().Connect( this, &Benchmark::OnTouch );
+    }
+
+    mFrameTimingRecorder.SampleMemory( "start" );
 
     if( gUseMesh )
     {
@@ -254,16 +292,46 @@ public:
       CreateImageViews();
     }
 
+    mFrameTimingRecorder.SampleMemory( "create", mRowsPerPage * mColumnsPerPage * mPageCount );
+
+    mFrameTimingRecorder.AddParameter( "test", "benchmark" );
+    mFrameTimingRecorder.AddParameter( "mode", gUseMesh ? "mesh" : "image-view" );
+    mFrameTimingRecorder.AddParameter( "ninePatch", gNinePatch ? "true" : "false" );
+    mFrameTimingRecorder.AddParameter( "rows", mRowsPerPage );
+    mFrameTimingRecorder.AddParameter( "columns", mColumnsPerPage );
+    mFrameTimingRecorder.AddParameter( "pages", mPageCount );
+    mFrameTimingRecorder.AddParameter( "actors", mRowsPerPage * mColumnsPerPage * mPageCount );
+    mFrameTimingRecorder.AddParameter( "headless", gHeadless ? "true" : "false" );
+    mFrameTimingRecorder.Start( "show" );
+
     ShowAnimation();
   }
 
   bool OnTouch( Actor actor, const TouchData& touch )
   {
     // quit the application
-    mApplication.Quit();
+    Quit();
     return true;
   }
 
+  void Quit()
+  {
+    mFrameTimingRecorder.Stop();
+    mApplication.Quit();
+  }
+
+  /**
+   * @brief Writes the frame timing report, once the main loop has finished.
+   */
+  void WriteReport()
+  {
+    mFrameTimingRecorder.WriteReport( gReportPath );
+    if( !gFrameTimesPath.empty() )
+    {
+      mFrameTimingRecorder.WriteFrameTimes( gFrameTimesPath );
+    }
+  }
+
   const char* ImagePath( int i )
   {
     return !gNinePatch ? IMAGE_PATH[i % NUM_IMAGES] : NINEPATCH_IMAGE_PATH[i % NUM_NINEPATCH_IMAGES];
@@ -314,15 +382,18 @@ public:
   {
     if( source == mShow )
     {
+      mFrameTimingRecorder.SampleMemory( "show" );
       ScrollAnimation();
     }
     else if( source == mScroll )
     {
+      mFrameTimingRecorder.SampleMemory( "scroll" );
       HideAnimation();
     }
     else
     {
-      mApplication.Quit();
+      mFrameTimingRecorder.SampleMemory( "hide" );
+      Quit();
     }
   }
 
@@ -375,7 +446,7 @@ public:
         ++count;
       }
     }
-    mShow.Play();
+    mClock.Play( mShow );
     mShow.FinishedSignal().Connect( this, &Benchmark::OnAnimationEnd );
   }
 
@@ -384,6 +455,7 @@ public:
     Stage stage = Stage::GetCurrent();
     Vector3 stageSize( stage.GetSize() );
 
+    mFrameTimingRecorder.SetPhase( "scroll" );
     mScroll = Animation::New(10.0f);
     size_t actorCount( mRowsPerPage*mColumnsPerPage*mPageCount);
     for( size_t i(0); i<actorCount; ++i )
@@ -403,7 +475,7 @@ public:
         mScroll.AnimateBy( Property( mImageView[i], Actor::Property::POSITION), Vector3( 12.0f*stageSize.x,0.0f, 0.0f), AlphaFunction::EASE_OUT, TimePeriod(8.0f,2.0f));
       }
     }
-    mScroll.Play();
+    mClock.Play( mScroll );
     mScroll.FinishedSignal().Connect( this, &Benchmark::OnAnimationEnd );
   }
 
@@ -411,6 +483,7 @@ public:
   {
     size_t count(0);
     unsigned int actorsPerPage( mRowsPerPage*mColumnsPerPage );
+    mFrameTimingRecorder.SetPhase( "hide" );
     mHide = Animation::New(0.0f);
 
     unsigned int totalColumns = mColumnsPerPage * mPageCount;
@@ -445,7 +518,7 @@ public:
       }
     }
 
-    mHide.Play();
+    mClock.Play( mHide );
     mHide.FinishedSignal().Connect( this, &Benchmark::OnAnimationEnd );
   }
 
@@ -463,6 +536,9 @@ private:
   Animation           mShow;
   Animation           mScroll;
   Animation           mHide;
+
+  DemoHelper::FrameTimingRecorder mFrameTimingRecorder;
+  DemoHelper::FixedStepClock      mClock;
 };
 
 void RunTest( Application& application )
@@ -470,17 +546,25 @@ void RunTest( Application& application )
   Benchmark test( application );
 
   application.MainLoop();
+
+  test.WriteReport();
 }
 
 // Entry point for Linux & Tizen applications
 //
 int DALI_EXPORT_API main( int argc, char **argv )
 {
-  Application application = Application::New( &argc, &argv );
+  // Arguments passed on to each run of a sweep or regression check
+  std::vector<std::string> runArguments;
 
   for( int i(1) ; i < argc; ++i )
   {
     std::string arg( argv[i] );
+    if( !DemoHelper::IsBenchmarkDriverArgument( arg ) )
+    {
+      runArguments.push_back( arg );
+    }
+
     if( arg.compare("--use-mesh") == 0)
     {
       gUseMesh = true;
@@ -501,8 +585,71 @@ int DALI_EXPORT_API main( int argc, char **argv )
     {
       gPageCount = atoi( arg.substr( 2, arg.size()).c_str());
     }
+    else if( arg.compare("--headless" ) == 0)
+    {
+      gHeadless = true;
+    }
+    else if( arg.compare(0, 13, "--frame-step=" ) == 0)
+    {
+      gFrameStep = atoi( arg.substr( 13 ).c_str());
+    }
+    else if( arg.compare(0, 9, "--report=" ) == 0)
+    {
+      gReportPath = arg.substr( 9 );
+    }
+    else if( arg.compare(0, 8, "--sweep=" ) == 0)
+    {
+      gSweep = arg.substr( 8 );
+    }
+    else if( arg.compare("--sweep" ) == 0 && i + 1 < argc )
+    {
+      gSweep = argv[++i];
+    }
+    else if( arg.compare(0, 14, "--frame-times=" ) == 0)
+    {
+      gFrameTimesPath = arg.substr( 14 );
+    }
+    else if( arg.compare(0, 11, "--baseline=" ) == 0)
+    {
+      gBaselinePath = arg.substr( 11 );
+    }
+    else if( arg.compare(0, 16, "--save-baseline=" ) == 0)
+    {
+      gSaveBaselinePath = arg.substr( 16 );
+    }
+    else if( arg.compare(0, 7, "--runs=" ) == 0)
+    {
+      gRegressionOptions.mRuns = atoi( arg.substr( 7 ).c_str());
+    }
+    else if( arg.compare(0, 17, "--max-regression=" ) == 0)
+    {
+      gRegressionOptions.mMaxRegression = atof( arg.substr( 17 ).c_str());
+    }
+  }
+
+  if( !gSweep.empty() )
+  {
+    std::vector<DemoHelper::SweepDimension> dimensions;
+    if( !DemoHelper::ParseSweep( gSweep, SWEEP_OPTIONS, NUM_SWEEP_OPTIONS, dimensions ) )
+    {
+      return EXIT_FAILURE;
+    }
+    return DemoHelper::RunSweep( argv[0], runArguments, dimensions, gReportPath );
+  }
+
+  if( !gSaveBaselinePath.empty() )
+  {
+    return DemoHelper::RecordBaseline( argv[0], runArguments, gSaveBaselinePath, gRegressionOptions );
   }
 
+  if( !gBaselinePath.empty() )
+  {
+    return DemoHelper::CheckRegression( argv[0], runArguments, gBaselinePath, gRegressionOptions );
+  }
+
+  Application application = Application::New( &argc, &argv );
+  DemoHelper::ReportLaunchTiming( application );
+
   RunTest( application );
 
   return 0;
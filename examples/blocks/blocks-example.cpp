@@ -24,6 +24,7 @@
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
 #include "shared/view.h"
+#include "shared/launch-timing.h"
 
 using namespace Dali;
 using namespace Dali::Toolkit;
@@ -850,6 +851,7 @@ void RunTest(Application& app)
 int DALI_EXPORT_API main(int argc, char **argv)
 {
   Application app = Application::New(&argc, &argv, DEMO_THEME_PATH);
+  DemoHelper::ReportLaunchTiming( app );
 
   RunTest(app);
 
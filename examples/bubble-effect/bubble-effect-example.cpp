@@ -20,6 +20,7 @@
 #include <dali-toolkit/devel-api/controls/bubble-effect/bubble-emitter.h>
 #include "shared/view.h"
 #include "shared/utility.h"
+#include "shared/launch-timing.h"
 
 using namespace Dali;
 
@@ -306,6 +307,7 @@ RunTest(Application& app)
 int DALI_EXPORT_API main(int argc, char **argv)
 {
   Application app = Application::New(&argc, &argv, DEMO_THEME_PATH);
+  DemoHelper::ReportLaunchTiming( app );
 
   RunTest(app);
 
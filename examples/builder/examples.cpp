@@ -23,8 +23,6 @@
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali-toolkit/devel-api/builder/builder.h>
-#include <dali-toolkit/devel-api/builder/tree-node.h>
-#include <dali-toolkit/devel-api/builder/json-parser.h>
 #include <dali-toolkit/devel-api/controls/popup/popup.h>
 #include <dali-toolkit/devel-api/controls/navigation-view/navigation-view.h>
 
@@ -33,7 +31,6 @@
 #include <fstream>
 #include <streambuf>
 #include <sstream>
-#include <dirent.h>
 #include <stdio.h>
 #include <iostream>
 
@@ -43,6 +40,9 @@
 
 #include <dali/integration-api/debug.h>
 #include "shared/view.h"
+#include "shared/compiled-layout.h"
+#include "shared/launch-timing.h"
+#include "script-index.h"
 
 #define TOKEN_STRING(x) #x
 
@@ -85,53 +85,12 @@ std::string ReplaceQuotes(const std::string &single_quoted)
 
 std::string GetFileContents(const std::string &fn)
 {
-  std::ifstream t(fn.c_str());
-  return std::string((std::istreambuf_iterator<char>(t)),
-                     std::istreambuf_iterator<char>());
+  // The compiled layout, if it is installed and up to date, so an edited script is read as it is
+  return DemoHelper::ReadLayout(fn);
 };
 
 typedef std::vector<std::string> FileList;
 
-void DirectoryFileList(const std::string& directory, FileList& files)
-{
-  DIR           *d;
-  struct dirent *dir;
-  d = opendir(directory.c_str());
-  if (d)
-  {
-    while ((dir = readdir(d)) != NULL)
-    {
-      if (dir->d_type == DT_REG)
-      {
-        files.push_back( directory + std::string(dir->d_name) );
-      }
-    }
-
-    closedir(d);
-  }
-}
-
-void DirectoryFilesByType(const std::string& dir, const std::string& fileType /* ie "json" */, FileList& files)
-{
-  typedef FileList Collection;
-  typedef FileList::iterator Iter;
-
-  Collection allFiles;
-  DirectoryFileList(dir, allFiles);
-
-  for(Iter iter = allFiles.begin(); iter != allFiles.end(); ++iter)
-  {
-    size_t pos = (*iter).rfind( '.' );
-    if( pos != std::string::npos )
-    {
-      if( (*iter).substr( pos+1 ) == fileType )
-      {
-        files.push_back( (*iter) );
-      }
-    }
-  }
-}
-
 const std::string ShortName( const std::string& name )
 {
   size_t pos = name.rfind( '/' );
@@ -279,66 +238,51 @@ public:
 
     mItemView.SetKeyboardFocusable( true );
 
-    mFiles.clear();
-    FileList files;
+    // Activate the layout
+    Vector3 size(stage.GetSize());
+    mItemView.ActivateLayout(0, size, 0.0f/*immediate*/);
 
-    if( USER_DIRECTORY.size() )
-    {
-      DirectoryFilesByType( USER_DIRECTORY, "json", files );
-    }
-    else
-    {
-      DirectoryFilesByType( DEMO_SCRIPT_DIR, "json", files );
-    }
+    // The scripts are added when they have been found and parsed, off the event thread
+    mScriptIndex.Scan( USER_DIRECTORY.size() ? USER_DIRECTORY : DEMO_SCRIPT_DIR,
+                       MakeCallback( this, &ExampleApp::OnScriptsScanned ) );
+  }
 
-    std::sort(files.begin(), files.end());
+  void OnScriptsScanned()
+  {
+    ScriptIndex::Scripts scripts;
+    mScriptIndex.TakeScripts( scripts );
 
-    ItemId itemId = 0;
-    for(FileList::iterator iter = files.begin(); iter != files.end(); ++iter)
+    for(ScriptIndex::Scripts::iterator iter = scripts.begin(); iter != scripts.end(); ++iter)
     {
-      JsonParser parser = JsonParser::New();
-
-      std::string data( GetFileContents( *iter ) );
-
-      parser.Parse( data );
-
-      if( parser.ParseError() )
-      {
-        std::cout << "Parser Error:" << *iter << std::endl;
-        std::cout << parser.GetErrorLineNumber() << "(" << parser.GetErrorColumn() << "):" << parser.GetErrorDescription() << std::endl;
-        exit(1);
-      }
-
-      if( parser.GetRoot() )
+      switch( iter->status )
       {
-        if( const TreeNode* node = parser.GetRoot()->Find("stage") )
+        case ScriptIndex::VALID:
         {
           // only those with a stage section
-          if( node->Size() )
-          {
-            mFiles.push_back( *iter );
-
-            mItemView.InsertItem( Item(itemId,
-                                       MenuItem( ShortName( *iter ) ) ),
-                                  0.5f );
-
-            itemId++;
-          }
-          else
-          {
-            std::cout << "Ignored file (stage has no nodes?):" << *iter << std::endl;
-          }
+          mFiles.push_back( iter->path );
+          break;
         }
-        else
+        case ScriptIndex::PARSE_ERROR:
         {
-          std::cout << "Ignored file (no stage section):" << *iter << std::endl;
+          std::cout << "Parser Error:" << iter->path << std::endl;
+          std::cout << iter->error << std::endl;
+          break;
+        }
+        case ScriptIndex::NO_STAGE:
+        {
+          std::cout << "Ignored file (no stage section):" << iter->path << std::endl;
+          break;
+        }
+        case ScriptIndex::EMPTY_STAGE:
+        {
+          std::cout << "Ignored file (stage has no nodes?):" << iter->path << std::endl;
+          break;
         }
       }
     }
 
-    // Activate the layout
-    Vector3 size(stage.GetSize());
-    mItemView.ActivateLayout(0, size, 0.0f/*immediate*/);
+    // The item view asks for the items it shows, see NewItem()
+    mItemView.Refresh();
   }
 
 
@@ -518,9 +462,29 @@ public:
   virtual Actor NewItem(unsigned int itemId)
   {
     DALI_ASSERT_DEBUG( itemId < mFiles.size() );
+
+    // Reuse a label that has scrolled out of view if there is one
+    if( !mItemPool.empty() )
+    {
+      TextLabel label = mItemPool.back();
+      mItemPool.pop_back();
+      label.SetProperty( TextLabel::Property::TEXT, ShortName( mFiles[itemId] ) );
+      return label;
+    }
+
     return MenuItem( ShortName( mFiles[itemId] ) );
   }
 
+  virtual void ItemReleased(unsigned int itemId, Actor actor)
+  {
+    // Still attached to the tap detector
+    TextLabel label = TextLabel::DownCast( actor );
+    if( label )
+    {
+      mItemPool.push_back( label );
+    }
+  }
+
   /**
    * Main key event handler
    */
@@ -573,6 +537,8 @@ private:
   Builder mBuilder;
 
   FileList mFiles;
+  ScriptIndex mScriptIndex;
+  std::vector<TextLabel> mItemPool;  ///< Items the item view no longer shows, to reuse
 
   FileWatcher mFileWatcher;
   Timer mTimer;
@@ -596,6 +562,7 @@ int DALI_EXPORT_API main(int argc, char **argv)
   }
 
   Application app = Application::New(&argc, &argv, DEMO_THEME_PATH);
+  DemoHelper::ReportLaunchTiming( app );
 
   ExampleApp dali_app(app);
 
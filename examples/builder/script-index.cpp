@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// CLASS HEADER
+#include "script-index.h"
+
+// EXTERNAL INCLUDES
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <dali-toolkit/devel-api/builder/json-parser.h>
+#include <dali-toolkit/devel-api/builder/tree-node.h>
+
+// INTERNAL INCLUDES
+#include "shared/cache-directory.h"
+
+using namespace Dali;
+using namespace Dali::Toolkit;
+
+namespace
+{
+
+const char* const INDEX_FILE = "/builder-script-index";
+const char* const INDEX_HEADER = "dali-demo builder script index 1"; ///< Change it when the format changes
+const unsigned int MAX_WORKERS = 8u;
+
+typedef std::map<std::string, ScriptIndex::Script> Index; ///< Keyed by path
+
+std::string GetIndexPath()
+{
+  const std::string directory = DemoHelper::GetCacheDirectory();
+  return directory.empty() ? directory : directory + INDEX_FILE;
+}
+
+/**
+ * Reads the index, a line of tab separated fields for each script.
+ */
+void ReadIndex( const std::string& path, Index& index )
+{
+  std::ifstream file( path.c_str() );
+  std::string line;
+  if( !std::getline( file, line ) || line != INDEX_HEADER )
+  {
+    return;
+  }
+
+  while( std::getline( file, line ) )
+  {
+    std::vector<std::string> fields;
+    std::istringstream stream( line );
+    std::string field;
+    while( std::getline( stream, field, '\t' ) )
+    {
+      fields.push_back( field );
+    }
+    if( line.size() && line[ line.size() - 1 ] == '\t' )
+    {
+      fields.push_back( std::string() );
+    }
+
+    int status = 0;
+    ScriptIndex::Script script;
+    if( fields.size() == 6u &&
+        std::istringstream( fields[0] ) >> script.size &&
+        std::istringstream( fields[1] ) >> script.modifiedSeconds &&
+        std::istringstream( fields[2] ) >> script.modifiedNanoseconds &&
+        std::istringstream( fields[3] ) >> status &&
+        status >= ScriptIndex::VALID && status <= ScriptIndex::EMPTY_STAGE )
+    {
+      script.status = static_cast<ScriptIndex::Status>( status );
+      script.path = fields[4];
+      script.error = fields[5];
+      index[ script.path ] = script;
+    }
+  }
+}
+
+/**
+ * Writes the index. It is written under a temporary name first, so other processes
+ * never read a partially written index.
+ */
+void WriteIndex( const std::string& path, const Index& index )
+{
+  std::ostringstream temporaryPath;
+  temporaryPath << path << "." << getpid() << ".tmp";
+
+  std::ofstream file( temporaryPath.str().c_str() );
+  file << INDEX_HEADER << '\n';
+  for( Index::const_iterator iter = index.begin(); iter != index.end(); ++iter )
+  {
+    const ScriptIndex::Script& script = iter->second;
+    file << script.size << '\t' << script.modifiedSeconds << '\t' << script.modifiedNanoseconds << '\t'
+         << script.status << '\t' << script.path << '\t' << script.error << '\n';
+  }
+  file.close();
+
+  if( file )
+  {
+    rename( temporaryPath.str().c_str(), path.c_str() );
+  }
+  else
+  {
+    unlink( temporaryPath.str().c_str() );
+  }
+}
+
+/**
+ * Whether a script can be written to the index without breaking its lines.
+ */
+bool CanIndex( const ScriptIndex::Script& script )
+{
+  return script.path.find_first_of( "\t\n" ) == std::string::npos &&
+         script.error.find_first_of( "\t\n" ) == std::string::npos;
+}
+
+/**
+ * Parses a script to find out whether it can be shown. Runs on a worker thread.
+ */
+void Validate( ScriptIndex::Script& script )
+{
+  std::ifstream file( script.path.c_str() );
+  const std::string data( ( std::istreambuf_iterator<char>( file ) ), std::istreambuf_iterator<char>() );
+
+  JsonParser parser = JsonParser::New();
+  parser.Parse( data );
+
+  if( parser.ParseError() )
+  {
+    std::ostringstream error;
+    error << parser.GetErrorLineNumber() << "(" << parser.GetErrorColumn() << "):" << parser.GetErrorDescription();
+    script.status = ScriptIndex::PARSE_ERROR;
+    script.error = error.str();
+  }
+  else
+  {
+    const TreeNode* stage = parser.GetRoot() ? parser.GetRoot()->Find( "stage" ) : NULL;
+    script.status = !stage ? ScriptIndex::NO_STAGE : stage->Size() ? ScriptIndex::VALID : ScriptIndex::EMPTY_STAGE;
+  }
+}
+
+/**
+ * The scripts being validated by the workers.
+ */
+struct Validation
+{
+  std::vector<ScriptIndex::Script*> scripts;
+  size_t                            next;     ///< The next script to validate
+  pthread_mutex_t                   mutex;    ///< Guards next
+};
+
+void* ValidateThread( void* data )
+{
+  Validation* validation = static_cast<Validation*>( data );
+  for( ;; )
+  {
+    pthread_mutex_lock( &validation->mutex );
+    const size_t index = validation->next++;
+    pthread_mutex_unlock( &validation->mutex );
+
+    if( index >= validation->scripts.size() )
+    {
+      return NULL;
+    }
+    Validate( *validation->scripts[ index ] );
+  }
+}
+
+/**
+ * Validates scripts on up to one worker per processor, including the calling thread.
+ */
+void ValidateAll( const std::vector<ScriptIndex::Script*>& scripts )
+{
+  Validation validation;
+  validation.scripts = scripts;
+  validation.next = 0u;
+  pthread_mutex_init( &validation.mutex, NULL );
+
+  const long processors = sysconf( _SC_NPROCESSORS_ONLN );
+  const size_t workerCount = std::min( static_cast<size_t>( std::max( processors, 1L ) ),
+                                       std::min( static_cast<size_t>( MAX_WORKERS ), scripts.size() ) );
+
+  std::vector<pthread_t> workers;
+  for( size_t i = 1; i < workerCount; ++i )
+  {
+    pthread_t worker;
+    if( pthread_create( &worker, NULL, &ValidateThread, &validation ) == 0 )
+    {
+      workers.push_back( worker );
+    }
+  }
+
+  ValidateThread( &validation );
+  for( std::vector<pthread_t>::iterator iter = workers.begin(); iter != workers.end(); ++iter )
+  {
+    pthread_join( *iter, NULL );
+  }
+
+  pthread_mutex_destroy( &validation.mutex );
+}
+
+} // namespace
+
+ScriptIndex::ScriptIndex()
+: mFinishedTrigger( NULL ),
+  mThread(),
+  mThreadStarted( false )
+{
+  pthread_mutex_init( &mMutex, NULL );
+}
+
+ScriptIndex::~ScriptIndex()
+{
+  if( mThreadStarted )
+  {
+    pthread_join( mThread, NULL );
+  }
+  delete mFinishedTrigger;
+  pthread_mutex_destroy( &mMutex );
+}
+
+void ScriptIndex::Scan( const std::string& directory, CallbackBase* finishedCallback )
+{
+  if( mThreadStarted )
+  {
+    pthread_join( mThread, NULL );
+    mThreadStarted = false;
+  }
+  delete mFinishedTrigger;
+
+  mDirectory = directory;
+  mFinishedTrigger = new EventThreadCallback( finishedCallback );
+
+  if( pthread_create( &mThread, NULL, &ScriptIndex::ScanThread, this ) == 0 )
+  {
+    mThreadStarted = true;
+  }
+  else
+  {
+    DoScan();
+  }
+}
+
+void ScriptIndex::TakeScripts( Scripts& scripts )
+{
+  pthread_mutex_lock( &mMutex );
+  scripts.swap( mScripts );
+  mScripts.clear();
+  pthread_mutex_unlock( &mMutex );
+}
+
+void* ScriptIndex::ScanThread( void* data )
+{
+  static_cast<ScriptIndex*>( data )->DoScan();
+  return NULL;
+}
+
+void ScriptIndex::DoScan()
+{
+  std::vector<std::string> paths;
+  if( DIR* directory = opendir( mDirectory.c_str() ) )
+  {
+    while( dirent* entry = readdir( directory ) )
+    {
+      const std::string name( entry->d_name );
+      const size_t extension = name.rfind( '.' );
+      if( extension != std::string::npos && name.substr( extension + 1 ) == "json" )
+      {
+        paths.push_back( mDirectory + name );
+      }
+    }
+    closedir( directory );
+  }
+  std::sort( paths.begin(), paths.end() );
+
+  const std::string indexPath = GetIndexPath();
+  Index index;
+  if( !indexPath.empty() )
+  {
+    ReadIndex( indexPath, index );
+  }
+
+  // Only the scripts that are new or have changed since they were indexed are parsed
+  Scripts scripts;
+  scripts.reserve( paths.size() );
+  std::vector<size_t> changed;
+  for( std::vector<std::string>::iterator iter = paths.begin(); iter != paths.end(); ++iter )
+  {
+    struct stat status;
+    if( stat( iter->c_str(), &status ) != 0 || !S_ISREG( status.st_mode ) )
+    {
+      continue;
+    }
+
+    Script script;
+    script.path = *iter;
+    script.size = status.st_size;
+    script.modifiedSeconds = status.st_mtim.tv_sec;
+    script.modifiedNanoseconds = status.st_mtim.tv_nsec;
+    script.status = PARSE_ERROR;
+
+    Index::const_iterator indexed = index.find( script.path );
+    if( indexed != index.end() &&
+        indexed->second.size == script.size &&
+        indexed->second.modifiedSeconds == script.modifiedSeconds &&
+        indexed->second.modifiedNanoseconds == script.modifiedNanoseconds )
+    {
+      script.status = indexed->second.status;
+      script.error = indexed->second.error;
+    }
+    else
+    {
+      changed.push_back( scripts.size() );
+    }
+    scripts.push_back( script );
+  }
+
+  std::vector<Script*> toValidate;
+  for( std::vector<size_t>::iterator iter = changed.begin(); iter != changed.end(); ++iter )
+  {
+    toValidate.push_back( &scripts[ *iter ] );
+  }
+  ValidateAll( toValidate );
+
+  // Replace the scripts of this directory in the index, keeping those of other directories
+  if( !indexPath.empty() )
+  {
+    size_t erased = 0u;
+    for( Index::iterator iter = index.begin(); iter != index.end(); )
+    {
+      const std::string& path = iter->first;
+      if( path.compare( 0, mDirectory.size(), mDirectory ) == 0 && path.find( '/', mDirectory.size() ) == std::string::npos )
+      {
+        index.erase( iter++ );
+        ++erased;
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+
+    for( Scripts::iterator iter = scripts.begin(); iter != scripts.end(); ++iter )
+    {
+      if( CanIndex( *iter ) )
+      {
+        index[ iter->path ] = *iter;
+      }
+    }
+
+    // Unless a script has changed or been deleted, the same entries were erased and added back
+    if( !changed.empty() || erased != scripts.size() )
+    {
+      WriteIndex( indexPath, index );
+    }
+  }
+
+  pthread_mutex_lock( &mMutex );
+  mScripts.swap( scripts );
+  pthread_mutex_unlock( &mMutex );
+
+  mFinishedTrigger->Trigger();
+}
@@ -0,0 +1,104 @@
+#ifndef DALI_DEMO_BUILDER_SCRIPT_INDEX_H
+#define DALI_DEMO_BUILDER_SCRIPT_INDEX_H
+
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include <dali/dali.h>
+#include <dali/devel-api/adaptor-framework/event-thread-callback.h>
+
+/**
+ * Finds the JSON scripts in a directory that can be shown, i.e. that parse and have
+ * a non-empty "stage" section.
+ *
+ * The directory is scanned on a worker thread, and the scripts are parsed on a pool of
+ * worker threads, each with its own JsonParser. The results are kept in an index in
+ * $XDG_CACHE_HOME/dali-demo (or ~/.cache/dali-demo) keyed by each script's path, size and
+ * modification time, so scripts that have not changed are not parsed again.
+ */
+class ScriptIndex
+{
+public:
+
+  enum Status
+  {
+    VALID,
+    PARSE_ERROR,
+    NO_STAGE,     ///< There is no "stage" section
+    EMPTY_STAGE   ///< The "stage" section has no actors
+  };
+
+  struct Script
+  {
+    std::string path;
+    long long   size;
+    long long   modifiedSeconds;
+    long        modifiedNanoseconds;
+    Status      status;
+    std::string error;      ///< Why it did not parse
+  };
+
+  typedef std::vector<Script> Scripts;
+
+  ScriptIndex();
+
+  /**
+   * Waits for a scan that has not finished.
+   */
+  ~ScriptIndex();
+
+  /**
+   * Starts scanning a directory for scripts with a .json extension.
+   *
+   * @param[in] directory The directory, ending with a '/'
+   * @param[in] finishedCallback Called on the event thread when the scan has finished; takes ownership
+   */
+  void Scan( const std::string& directory, Dali::CallbackBase* finishedCallback );
+
+  /**
+   * Takes the scripts found by a finished scan, sorted by path.
+   */
+  void TakeScripts( Scripts& scripts );
+
+private:
+
+  // Undefined
+  ScriptIndex( const ScriptIndex& );
+  ScriptIndex& operator=( const ScriptIndex& );
+
+  static void* ScanThread( void* data );
+
+  /**
+   * Scans the directory, validates the scripts that are not in the index and updates it.
+   */
+  void DoScan();
+
+private:
+
+  std::string                 mDirectory;
+  Dali::EventThreadCallback*  mFinishedTrigger;
+  pthread_t                   mThread;
+  bool                        mThreadStarted;
+  pthread_mutex_t             mMutex;            ///< Guards mScripts
+  Scripts                     mScripts;
+};
+
+#endif // DALI_DEMO_BUILDER_SCRIPT_INDEX_H
@@ -22,6 +22,7 @@
 
 // INTERNAL INCLUDES
 #include "shared/utility.h"
+#include "shared/launch-timing.h"
 
 using namespace Dali;
 using Dali::Toolkit::TextLabel;
@@ -215,6 +216,7 @@ void RunTest( Application& application )
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv );
+  DemoHelper::ReportLaunchTiming( application );
 
   RunTest( application );
 
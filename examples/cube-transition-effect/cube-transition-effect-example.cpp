@@ -21,6 +21,7 @@
 // INTERNAL INCLUDES
 #include "shared/view.h"
 #include "shared/utility.h"
+#include "shared/launch-timing.h"
 
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
@@ -418,6 +419,7 @@ void CubeTransitionApp::OnKeyEvent(const KeyEvent& event)
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv, DEMO_THEME_PATH );
+  DemoHelper::ReportLaunchTiming( application );
   CubeTransitionApp test( application );
   application.MainLoop();
 
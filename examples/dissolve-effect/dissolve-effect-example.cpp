@@ -20,6 +20,7 @@
 
 // INTERNAL INCLUDES
 #include "shared/view.h"
+#include "shared/launch-timing.h"
 
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
@@ -439,6 +440,7 @@ bool DissolveEffectApp::OnTimerTick()
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv, DEMO_THEME_PATH );
+  DemoHelper::ReportLaunchTiming( application );
   DissolveEffectApp test( application );
   application.MainLoop();
 
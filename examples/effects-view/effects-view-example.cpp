@@ -18,6 +18,7 @@
 
 // INTERNAL INCLUDES
 #include "shared/view.h"
+#include "shared/launch-timing.h"
 
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
@@ -256,6 +257,7 @@ static void RunTest( Application& application )
 int DALI_EXPORT_API main(int argc, char **argv)
 {
   Application application = Application::New(&argc, &argv, DEMO_THEME_PATH);
+  DemoHelper::ReportLaunchTiming( application );
 
   RunTest(application);
 
@@ -17,9 +17,19 @@
 
 // EXTERNAL INCLUDES
 #include <dali-toolkit/dali-toolkit.h>
+#include <dali-toolkit/devel-api/builder/json-parser.h>
+#include <dali-toolkit/devel-api/builder/tree-node.h>
+#include <algorithm>
+#include <fstream>
 #include <sstream>
 #include <iostream>
 
+// INTERNAL INCLUDES
+#include "shared/frame-timing-recorder.h"
+#include "shared/headless.h"
+#include "shared/benchmark-compare.h"
+#include "shared/launch-timing.h"
+
 using namespace Dali;
 using Dali::Toolkit::TextLabel;
 
@@ -41,6 +51,8 @@ const float DEFAULT_OPT_PAGE_COUNT          ( 10 );
 const bool  DEFAULT_OPT_USE_TABLEVIEW       ( true );
 const bool  DEFAULT_OPT_BATCHING_ENABLED    ( true );
 const bool  DEFAULT_OPT_ICON_LABELS         ( true );
+const bool  DEFAULT_OPT_HEADLESS            ( false );
+const unsigned int DEFAULT_OPT_FRAME_STEP   ( 16 );
 
 // The image/label area tries to make sure the positioning will be relative to previous sibling
 const float IMAGE_AREA                      ( 0.60f );
@@ -71,6 +83,33 @@ const char* DEMO_APPS_NAMES[] =
   "Ososrak",   "Pecertin",    "Perrd"
 };
 
+/**
+ * Names of the script steps, as used in scenario files and as frame timing phases.
+ * The order matches HomescreenBenchmark::ScriptData::Type.
+ */
+const char* SCRIPT_STEP_NAMES[] =
+{
+  "flick", "scroll", "drag", "pause", "jump", "orientation", "labels"
+};
+const unsigned int NUM_SCRIPT_STEP_NAMES = sizeof( SCRIPT_STEP_NAMES ) / sizeof( SCRIPT_STEP_NAMES[0] );
+
+/**
+ * Reads a numeric member of a scenario step, which may be written as an integer or a float.
+ */
+float GetNumber( const Toolkit::TreeNode& step, const char* name, float defaultValue )
+{
+  const Toolkit::TreeNode* node = step.GetChild( name );
+  if( node && node->GetType() == Toolkit::TreeNode::INTEGER )
+  {
+    return static_cast<float>( node->GetInteger() );
+  }
+  if( node && node->GetType() == Toolkit::TreeNode::FLOAT )
+  {
+    return node->GetFloat();
+  }
+  return defaultValue;
+}
+
 // This code comes from command-line-options.cpp. the reason it's here is to
 // keep consistent the extra-help formatting when '--help' used.
 void PrintHelp( const char * const opt, const char * const optDescription)
@@ -88,6 +127,34 @@ void PrintHelp( const char * const opt, const char * const optDescription)
 
 /**
  * @brief This example is a benchmark that mimics the paged applications list of the homescreen application.
+ *
+ * By default it plays a built-in scrolling script. A scenario recorded from real usage can be played
+ * instead with --script=<file>, where the file has the form:
+ *
+ * {
+ *   "steps":
+ *   [
+ *     { "type": "flick",       "pages": 3, "duration": 1.5 },
+ *     { "type": "scroll",      "pages": -2, "duration": 0.5 },
+ *     { "type": "drag",        "pages": 1, "duration": 0.8, "velocity": [ 0.0, 1.0, 0.6, 0.2, 0.0 ] },
+ *     { "type": "pause",       "duration": 2.0 },
+ *     { "type": "jump",        "page": 4 },
+ *     { "type": "orientation", "angle": 90, "duration": 0.5 },
+ *     { "type": "labels",      "visible": false }
+ *   ]
+ * }
+ *
+ * - flick:       Scrolls "pages" pages (negative to go back) in one movement.
+ * - scroll:      Scrolls "pages" pages one at a time, "duration" each.
+ * - drag:        Scrolls "pages" pages following the "velocity" curve.
+ * - pause:       Does nothing for "duration".
+ * - jump:        Moves to "page" without animating.
+ * - orientation: Rotates to "angle" degrees, laying the pages out for the new screen size.
+ * - labels:      Shows or hides the icon labels.
+ *
+ * Durations are in seconds. The velocity curve is sampled at evenly spaced times over the duration and
+ * only its shape matters; it is scaled so the drag covers the requested number of pages.
+ * Every step type is reported as a separate phase in the frame timing report.
  */
 class HomescreenBenchmark : public ConnectionTracker
 {
@@ -103,7 +170,9 @@ public:
       mPageCount( DEFAULT_OPT_PAGE_COUNT ),
       mTableViewEnabled( DEFAULT_OPT_USE_TABLEVIEW ),
       mBatchingEnabled( DEFAULT_OPT_BATCHING_ENABLED ),
-      mIconLabelsEnabled( DEFAULT_OPT_ICON_LABELS )
+      mIconLabelsEnabled( DEFAULT_OPT_ICON_LABELS ),
+      mHeadless( DEFAULT_OPT_HEADLESS ),
+      mFrameStep( DEFAULT_OPT_FRAME_STEP )
     {
     }
 
@@ -113,28 +182,60 @@ public:
     bool mTableViewEnabled;
     bool mBatchingEnabled;
     bool mIconLabelsEnabled;
+    bool mHeadless;
+    unsigned int mFrameStep;
+    std::string mReportPath;
+    std::string mFrameTimesPath;
+    std::string mScriptPath;
   };
 
   // animation script data
   struct ScriptData
   {
+    enum Type
+    {
+      FLICK,       ///< Scroll mPages pages in one movement
+      SCROLL,      ///< Scroll mPages pages one by one, mDuration each
+      DRAG,        ///< Scroll mPages pages following mVelocity
+      PAUSE,       ///< Do nothing for mDuration
+      JUMP,        ///< Move to page mPages without animating
+      ORIENTATION, ///< Rotate to mAngle and lay the pages out again
+      LABELS       ///< Show or hide the icon labels
+    };
+
     ScriptData( int pages, float duration, bool flick )
-    : mPages( pages ),
+    : mType( flick ? FLICK : SCROLL ),
+      mPages( pages ),
       mDuration( duration ),
-      mFlick( flick )
+      mAngle( 0.0f ),
+      mVisible( true )
     {
     }
 
-    int   mPages;    ///< Number of pages to scroll
-    float mDuration; ///< Duration
-    bool  mFlick;    ///< Use flick or 'one-by-one' scroll
+    ScriptData( Type type )
+    : mType( type ),
+      mPages( 0 ),
+      mDuration( 0.0f ),
+      mAngle( 0.0f ),
+      mVisible( true )
+    {
+    }
+
+    Type               mType;     ///< What the step does
+    int                mPages;    ///< Number of pages to scroll, or the page to jump to
+    float              mDuration; ///< Duration in seconds
+    float              mAngle;    ///< Orientation in degrees
+    bool               mVisible;  ///< Whether the labels are shown
+    std::vector<float> mVelocity; ///< Velocity curve of a drag, evenly spaced in time
   };
 
   HomescreenBenchmark( Application& application, const Config& config )
   : mApplication( application ),
     mConfig( config ),
     mScriptFrame( 0 ),
-    mCurrentPage( 0 )
+    mCurrentPage( 0 ),
+    mPageWidth( 0.0f ),
+    mScriptError( false )
   {
     // Connect to the Application's Init signal.
     mApplication.InitSignal().Connect( this, &HomescreenBenchmark::Create );
@@ -148,15 +249,38 @@ public:
   void Create( Application& application )
   {
     // Create benchmark script
-    CreateScript();
+    if( mConfig.mScriptPath.empty() )
+    {
+      CreateScript();
+    }
+    else if( !LoadScript( mConfig.mScriptPath ) )
+    {
+      mScriptError = true;
+      mApplication.Quit();
+      return;
+    }
+
+    if( mConfig.mHeadless )
+    {
+      mClock.Enable( mConfig.mFrameStep );
+    }
 
     // Get a handle to the stage
     Stage stage = Stage::GetCurrent();
+    mPageWidth = stage.GetSize().width;
+
+    // The rotation parent takes the size of the screen in the current orientation,
+    // the scroll parent moves the pages within it.
+    mRotationParent = Actor::New();
+    mRotationParent.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::ALL_DIMENSIONS );
+    mRotationParent.SetAnchorPoint( AnchorPoint::CENTER );
+    mRotationParent.SetParentOrigin( ParentOrigin::CENTER );
 
     mScrollParent = Actor::New();
     mScrollParent.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::ALL_DIMENSIONS );
     mScrollParent.SetAnchorPoint( AnchorPoint::CENTER );
     mScrollParent.SetParentOrigin( ParentOrigin::CENTER );
+    mRotationParent.Add( mScrollParent );
 
     // create background
     Toolkit::ImageView background = Toolkit::ImageView::New( BACKGROUND_IMAGE );
@@ -167,19 +291,52 @@ public:
 
     PopulatePages();
 
-    stage.Add( mScrollParent );
+    stage.Add( mRotationParent );
 
-    // Respond to a click anywhere on the stage.
-    stage.GetRootLayer().TouchSignal().Connect( this, &HomescreenBenchmark::OnTouch );
+    if( mConfig.mHeadless )
+    {
+      DemoHelper::RenderOffscreen();
+    }
+    else
+    {
+      // Respond to a click anywhere on the stage.
+      stage.GetRootLayer().TouchSignal().Connect( this, &HomescreenBenchmark::OnTouch );
+    }
   }
 
   bool OnTouch( Actor actor, const TouchData& touch )
   {
     // Quit the application.
-    mApplication.Quit();
+    Quit();
     return true;
   }
 
+  void Quit()
+  {
+    mFrameTimingRecorder.Stop();
+    mApplication.Quit();
+  }
+
+  /**
+   * @brief Whether the scenario file given with --script could not be loaded.
+   */
+  bool HasScriptError() const
+  {
+    return mScriptError;
+  }
+
+  /**
+   * @brief Writes the frame timing report, once the main loop has finished.
+   */
+  void WriteReport()
+  {
+    mFrameTimingRecorder.WriteReport( mConfig.mReportPath );
+    if( !mConfig.mFrameTimesPath.empty() )
+    {
+      mFrameTimingRecorder.WriteFrameTimes( mConfig.mFrameTimesPath );
+    }
+  }
+
   Actor AddPage()
   {
     // Create root page actor.
@@ -272,6 +429,7 @@ public:
           textLabel.SetProperty( Toolkit::TextLabel::Property::HORIZONTAL_ALIGNMENT, "CENTER" );
           textLabel.SetProperty( Toolkit::TextLabel::Property::VERTICAL_ALIGNMENT, "TOP" );
           imageView.Add( textLabel );
+          mLabels.push_back( textLabel );
         }
 
         iconView.Add( imageView );
@@ -307,12 +465,90 @@ public:
     mScriptFrameData.push_back( ScriptData( 1,         0.1f, true  ) );
     mScriptFrameData.push_back( ScriptData( -1,        0.1f, true  ) );
     mScriptFrameData.push_back( ScriptData( halfA,     1.0f, true  ) );
+
+    // The built-in script is written in units of PAGE_DURATION_SCALE_FACTOR seconds.
+    for( size_t i = 0; i < mScriptFrameData.size(); ++i )
+    {
+      mScriptFrameData[i].mDuration *= PAGE_DURATION_SCALE_FACTOR;
+    }
+  }
+
+  /**
+   * @brief Loads the script from a scenario file, see the class description for the format.
+   * @return false, after printing the reason, if the file cannot be used.
+   */
+  bool LoadScript( const std::string& path )
+  {
+    std::ifstream file( path.c_str() );
+    if( !file )
+    {
+      std::cerr << "Unable to open scenario: " << path << std::endl;
+      return false;
+    }
+    std::string data( ( std::istreambuf_iterator<char>( file ) ), std::istreambuf_iterator<char>() );
+
+    Toolkit::JsonParser parser = Toolkit::JsonParser::New();
+    parser.Parse( data );
+    if( parser.ParseError() )
+    {
+      std::cerr << path << ":" << parser.GetErrorLineNumber() << "(" << parser.GetErrorColumn() << "): " << parser.GetErrorDescription() << std::endl;
+      return false;
+    }
+
+    const Toolkit::TreeNode* steps = parser.GetRoot() ? parser.GetRoot()->GetChild( "steps" ) : NULL;
+    if( !steps || steps->GetType() != Toolkit::TreeNode::ARRAY )
+    {
+      std::cerr << path << ": no \"steps\" array" << std::endl;
+      return false;
+    }
+
+    for( Toolkit::TreeNode::ConstIterator iter = steps->CBegin(); iter != steps->CEnd(); ++iter )
+    {
+      const Toolkit::TreeNode& step = (*iter).second;
+      const Toolkit::TreeNode* typeNode = step.GetChild( "type" );
+      const std::string type( typeNode && typeNode->GetType() == Toolkit::TreeNode::STRING ? typeNode->GetString() : "" );
+
+      unsigned int typeIndex = 0u;
+      while( typeIndex < NUM_SCRIPT_STEP_NAMES && type != SCRIPT_STEP_NAMES[typeIndex] )
+      {
+        ++typeIndex;
+      }
+      if( typeIndex == NUM_SCRIPT_STEP_NAMES )
+      {
+        std::cerr << path << ": unknown step type \"" << type << "\"" << std::endl;
+        return false;
+      }
+
+      ScriptData frame( static_cast<ScriptData::Type>( typeIndex ) );
+      frame.mPages = static_cast<int>( GetNumber( step, frame.mType == ScriptData::JUMP ? "page" : "pages", 0.0f ) );
+      frame.mDuration = GetNumber( step, "duration", 0.0f );
+      frame.mAngle = GetNumber( step, "angle", 0.0f );
+
+      const Toolkit::TreeNode* visible = step.GetChild( "visible" );
+      frame.mVisible = !visible || visible->GetType() != Toolkit::TreeNode::BOOLEAN || visible->GetBoolean();
+
+      const Toolkit::TreeNode* velocity = step.GetChild( "velocity" );
+      if( velocity && velocity->GetType() == Toolkit::TreeNode::ARRAY )
+      {
+        for( Toolkit::TreeNode::ConstIterator sample = velocity->CBegin(); sample != velocity->CEnd(); ++sample )
+        {
+          const Toolkit::TreeNode& value = (*sample).second;
+          frame.mVelocity.push_back( value.GetType() == Toolkit::TreeNode::INTEGER ? static_cast<float>( value.GetInteger() ) : value.GetFloat() );
+        }
+      }
+
+      mScriptFrameData.push_back( frame );
+    }
+
+    return true;
   }
 
   void PopulatePages()
   {
     Vector3 stageSize( Stage::GetCurrent().GetSize() );
 
+    mFrameTimingRecorder.SampleMemory( "start" );
+
     for( int i = 0; i < mConfig.mPageCount; ++i )
     {
       // Create page.
@@ -326,6 +562,7 @@ public:
       page.SetAnchorPoint( AnchorPoint::CENTER );
       page.SetPosition( Vector3( stageSize.x * i, 0.0f, 0.0f ) );
       mScrollParent.Add( page );
+      mPages.push_back( page );
 
       if( mConfig.mTableViewEnabled && mConfig.mBatchingEnabled )
       {
@@ -336,6 +573,20 @@ public:
     mScrollParent.SetOpacity( 1.0f );
     mScrollParent.SetScale( Vector3::ONE );
 
+    // Each icon is a control, an image view and optionally a label.
+    const unsigned int iconCount = mConfig.mRows * mConfig.mCols * mConfig.mPageCount;
+    mFrameTimingRecorder.SampleMemory( "create", iconCount * ( mConfig.mIconLabelsEnabled ? 3u : 2u ) + mConfig.mPageCount );
+
+    mFrameTimingRecorder.AddParameter( "test", "homescreen-benchmark" );
+    mFrameTimingRecorder.AddParameter( "rows", mConfig.mRows );
+    mFrameTimingRecorder.AddParameter( "columns", mConfig.mCols );
+    mFrameTimingRecorder.AddParameter( "pages", mConfig.mPageCount );
+    mFrameTimingRecorder.AddParameter( "tableView", mConfig.mTableViewEnabled ? "true" : "false" );
+    mFrameTimingRecorder.AddParameter( "batching", mConfig.mBatchingEnabled ? "true" : "false" );
+    mFrameTimingRecorder.AddParameter( "iconLabels", mConfig.mIconLabelsEnabled ? "true" : "false" );
+    mFrameTimingRecorder.AddParameter( "headless", mConfig.mHeadless ? "true" : "false" );
+    mFrameTimingRecorder.Start( "show" );
+
     // Fade in.
     ShowAnimation();
   }
@@ -346,58 +597,174 @@ public:
     mShowAnimation.AnimateTo( Property( mScrollParent, Actor::Property::COLOR_ALPHA ), 1.0f, AlphaFunction::EASE_IN_OUT );
     mShowAnimation.AnimateTo( Property( mScrollParent, Actor::Property::SCALE ), Vector3::ONE, AlphaFunction::EASE_IN_OUT );
     mShowAnimation.FinishedSignal().Connect( this, &HomescreenBenchmark::OnAnimationEnd );
-    mShowAnimation.Play();
+    mClock.Play( mShowAnimation );
   }
 
-  void ScrollPages(int pages, float duration, bool flick)
+  void ScrollPages( int pages, float duration, bool flick )
   {
-    duration *= PAGE_DURATION_SCALE_FACTOR;
-    Vector3 stageSize( Stage::GetCurrent().GetSize() );
-    mScrollAnimation = Animation::New( duration );
     if( flick )
     {
-      mScrollAnimation.AnimateBy( Property( mScrollParent, Actor::Property::POSITION ), Vector3( -stageSize.x * pages, 0.0f, 0.0f ), AlphaFunction::EASE_IN_OUT );
+      mScrollAnimation.AnimateBy( Property( mScrollParent, Actor::Property::POSITION ), Vector3( -mPageWidth * pages, 0.0f, 0.0f ), AlphaFunction::EASE_IN_OUT );
     }
     else
     {
       int totalPages = abs( pages );
       for( int i = 0; i < totalPages; ++i )
       {
-        mScrollAnimation.AnimateBy( Property( mScrollParent, Actor::Property::POSITION ), Vector3( pages < 0 ? stageSize.x : -stageSize.x, 0.0f, 0.0f ), AlphaFunction::EASE_IN_OUT, TimePeriod( duration * i, duration ) );
+        mScrollAnimation.AnimateBy( Property( mScrollParent, Actor::Property::POSITION ), Vector3( pages < 0 ? mPageWidth : -mPageWidth, 0.0f, 0.0f ), AlphaFunction::EASE_IN_OUT, TimePeriod( duration * i, duration ) );
       }
     }
-    mScrollAnimation.FinishedSignal().Connect( this, &HomescreenBenchmark::OnAnimationEnd );
-    mScrollAnimation.Play();
     mCurrentPage += pages;
   }
 
+  void DragPages( int pages, const std::vector<float>& velocity )
+  {
+    if( velocity.size() < 2u )
+    {
+      ScrollPages( pages, 0.0f, true );
+      return;
+    }
+
+    // Integrate the velocity curve (linear between samples) into the distance covered at each sample.
+    std::vector<float> distance( velocity.size(), 0.0f );
+    for( size_t i = 1; i < velocity.size(); ++i )
+    {
+      distance[i] = distance[i - 1] + ( velocity[i - 1] + velocity[i] ) * 0.5f;
+    }
+    const float totalDistance = distance.back();
+
+    const float startX = -mPageWidth * mCurrentPage;
+    const float endX = startX - mPageWidth * pages;
+    KeyFrames keyFrames = KeyFrames::New();
+    for( size_t i = 0; i < distance.size(); ++i )
+    {
+      const float progress = static_cast<float>( i ) / ( distance.size() - 1u );
+      const float travelled = totalDistance > 0.0f ? distance[i] / totalDistance : progress;
+      keyFrames.Add( progress, Vector3( startX + ( endX - startX ) * travelled, 0.0f, 0.0f ) );
+    }
+    mScrollAnimation.AnimateBetween( Property( mScrollParent, Actor::Property::POSITION ), keyFrames );
+    mCurrentPage += pages;
+  }
+
+  void JumpToPage( int page )
+  {
+    mCurrentPage = std::max( 0, std::min( page, mConfig.mPageCount - 1 ) );
+    mScrollAnimation.AnimateTo( Property( mScrollParent, Actor::Property::POSITION ), Vector3( -mPageWidth * mCurrentPage, 0.0f, 0.0f ) );
+  }
+
+  void ChangeOrientation( float angle )
+  {
+    // Lay the pages out for the new screen size; the pages are sized relative to their parent
+    // so this relayouts every page, as a real orientation change would.
+    Vector2 stageSize( Stage::GetCurrent().GetSize() );
+    const bool portrait = static_cast<int>( angle ) % 180 != 0;
+    Vector2 size( portrait ? stageSize.height : stageSize.width, portrait ? stageSize.width : stageSize.height );
+
+    mPageWidth = size.width;
+    mRotationParent.SetResizePolicy( ResizePolicy::FIXED, Dimension::ALL_DIMENSIONS );
+    mRotationParent.SetSize( size );
+    for( size_t i = 0; i < mPages.size(); ++i )
+    {
+      mPages[i].SetPosition( Vector3( mPageWidth * i, 0.0f, 0.0f ) );
+    }
+    mScrollParent.SetPosition( Vector3( -mPageWidth * mCurrentPage, 0.0f, 0.0f ) );
+
+    mScrollAnimation.AnimateTo( Property( mRotationParent, Actor::Property::ORIENTATION ), Quaternion( Radian( Degree( angle ) ), Vector3::ZAXIS ), AlphaFunction::EASE_IN_OUT );
+  }
+
+  void ShowLabels( bool visible )
+  {
+    for( size_t i = 0; i < mLabels.size(); ++i )
+    {
+      mLabels[i].SetVisible( visible );
+    }
+  }
+
+  void PlayScriptFrame( const ScriptData& frame )
+  {
+    mFrameTimingRecorder.SetPhase( SCRIPT_STEP_NAMES[frame.mType] );
+
+    // One-by-one scrolling takes the duration for each page.
+    const int totalPages = abs( frame.mPages );
+    mScrollAnimation = Animation::New( frame.mType == ScriptData::SCROLL && totalPages ? frame.mDuration * totalPages : frame.mDuration );
+
+    switch( frame.mType )
+    {
+      case ScriptData::FLICK:
+      case ScriptData::SCROLL:
+      {
+        ScrollPages( frame.mPages, frame.mDuration, frame.mType == ScriptData::FLICK );
+        break;
+      }
+      case ScriptData::DRAG:
+      {
+        DragPages( frame.mPages, frame.mVelocity );
+        break;
+      }
+      case ScriptData::PAUSE:
+      {
+        break;
+      }
+      case ScriptData::JUMP:
+      {
+        JumpToPage( frame.mPages );
+        break;
+      }
+      case ScriptData::ORIENTATION:
+      {
+        ChangeOrientation( frame.mAngle );
+        break;
+      }
+      case ScriptData::LABELS:
+      {
+        ShowLabels( frame.mVisible );
+        break;
+      }
+    }
+
+    mScrollAnimation.FinishedSignal().Connect( this, &HomescreenBenchmark::OnAnimationEnd );
+    mClock.Play( mScrollAnimation );
+  }
+
   void OnAnimationEnd( Animation& source )
   {
+    if( source == mShowAnimation )
+    {
+      mFrameTimingRecorder.SampleMemory( "show" );
+    }
+
     if( mScriptFrame < mScriptFrameData.size() )
     {
-      ScriptData& frame = mScriptFrameData[mScriptFrame];
-      ScrollPages( frame.mPages, frame.mDuration, frame.mFlick );
+      PlayScriptFrame( mScriptFrameData[mScriptFrame] );
       ++mScriptFrame;
     }
     else
     {
-      mApplication.Quit();
+      mFrameTimingRecorder.SampleMemory( "script" );
+      Quit();
     }
   }
 
 private:
 
   Application&                mApplication;
+  Actor                       mRotationParent;
   Actor                       mScrollParent;
+  std::vector<Actor>          mPages;
+  std::vector<Toolkit::TextLabel> mLabels;
   Animation                   mShowAnimation;
   Animation                   mScrollAnimation;
   Config                      mConfig;
   std::vector<ScriptData>     mScriptFrameData;
   size_t                      mScriptFrame;
   int                         mCurrentPage;
+  float                       mPageWidth;
+  bool                        mScriptError;
+  DemoHelper::FrameTimingRecorder mFrameTimingRecorder;
+  DemoHelper::FixedStepClock  mClock;
 };
 
-void RunTest( Application& application, const HomescreenBenchmark::Config& config, bool printHelpAndExit )
+int RunTest( Application& application, const HomescreenBenchmark::Config& config, bool printHelpAndExit )
 {
   HomescreenBenchmark test( application, config );
 
@@ -409,10 +776,27 @@ void RunTest( Application& application, const HomescreenBenchmark::Config& confi
     PrintHelp( "-disable-tableview",   " Disables the use of TableView for layouting (must be enabled for batching)" );
     PrintHelp( "-disable-batching",    " Disables geometry batching" );
     PrintHelp( "-disable-icon-labels", " Disables labels for each icon" );
-    return;
+    PrintHelp( "-headless",            " Renders offscreen, ignores touch and advances the animations by a fixed step per rendered frame" );
+    PrintHelp( "-frame-step=<ms>",     " The fixed step used by --headless" );
+    PrintHelp( "-report=<file>",       " Writes the frame timing report to <file> (CSV if it ends in .csv, JSON otherwise)" );
+    PrintHelp( "-frame-times=<file>",  " Writes the duration of every frame to <file>" );
+    PrintHelp( "-save-baseline=<file>"," Runs -runs times in fresh processes and saves the pooled frame times as a baseline" );
+    PrintHelp( "-baseline=<file>",     " Runs -runs times in fresh processes and fails if significantly slower than the baseline" );
+    PrintHelp( "-runs=<num>",          " Number of runs for -save-baseline and -baseline" );
+    PrintHelp( "-max-regression=<%>",  " Allowed growth of the p95 frame time for -baseline" );
+    PrintHelp( "-script=<file>",       " Plays the scenario in the JSON <file> instead of the built-in script" );
+    return EXIT_SUCCESS;
   }
 
   application.MainLoop();
+
+  if( test.HasScriptError() )
+  {
+    return EXIT_FAILURE;
+  }
+
+  test.WriteReport();
+  return EXIT_SUCCESS;
 }
 
 // Entry point for Linux & Tizen applications.
@@ -423,9 +807,20 @@ int DALI_EXPORT_API main( int argc, char **argv )
 
   bool printHelpAndExit = false;
 
+  // Regression check settings, and the arguments passed on to each of its runs.
+  std::string baselinePath;
+  std::string saveBaselinePath;
+  DemoHelper::RegressionOptions regressionOptions;
+  std::vector<std::string> runArguments;
+
   for( int i = 1 ; i < argc; ++i )
   {
     std::string arg( argv[i] );
+    if( !DemoHelper::IsBenchmarkDriverArgument( arg ) )
+    {
+      runArguments.push_back( arg );
+    }
+
     if( arg.compare( 0, 2, "-r" ) == 0 )
     {
       config.mRows = atoi( arg.substr( 2 ).c_str() );
@@ -450,15 +845,60 @@ int DALI_EXPORT_API main( int argc, char **argv )
     {
       config.mIconLabelsEnabled = false;
     }
+    else if( arg.compare( "--headless" ) == 0 )
+    {
+      config.mHeadless = true;
+    }
+    else if( arg.compare( 0, 13, "--frame-step=" ) == 0 )
+    {
+      config.mFrameStep = atoi( arg.substr( 13 ).c_str() );
+    }
+    else if( arg.compare( 0, 9, "--report=" ) == 0 )
+    {
+      config.mReportPath = arg.substr( 9 );
+    }
+    else if( arg.compare( 0, 9, "--script=" ) == 0 )
+    {
+      config.mScriptPath = arg.substr( 9 );
+    }
+    else if( arg.compare( 0, 14, "--frame-times=" ) == 0 )
+    {
+      config.mFrameTimesPath = arg.substr( 14 );
+    }
+    else if( arg.compare( 0, 11, "--baseline=" ) == 0 )
+    {
+      baselinePath = arg.substr( 11 );
+    }
+    else if( arg.compare( 0, 16, "--save-baseline=" ) == 0 )
+    {
+      saveBaselinePath = arg.substr( 16 );
+    }
+    else if( arg.compare( 0, 7, "--runs=" ) == 0 )
+    {
+      regressionOptions.mRuns = atoi( arg.substr( 7 ).c_str() );
+    }
+    else if( arg.compare( 0, 17, "--max-regression=" ) == 0 )
+    {
+      regressionOptions.mMaxRegression = atof( arg.substr( 17 ).c_str() );
+    }
     else if( arg.compare( "--help" ) == 0 )
     {
       printHelpAndExit = true;
     }
   }
 
-  Application application = Application::New( &argc, &argv );
+  if( !printHelpAndExit && !saveBaselinePath.empty() )
+  {
+    return DemoHelper::RecordBaseline( argv[0], runArguments, saveBaselinePath, regressionOptions );
+  }
 
-  RunTest( application, config, printHelpAndExit );
+  if( !printHelpAndExit && !baselinePath.empty() )
+  {
+    return DemoHelper::CheckRegression( argv[0], runArguments, baselinePath, regressionOptions );
+  }
+
+  Application application = Application::New( &argc, &argv );
+  DemoHelper::ReportLaunchTiming( application );
 
-  return 0;
+  return RunTest( application, config, printHelpAndExit );
 }
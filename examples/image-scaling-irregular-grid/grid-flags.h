@@ -18,7 +18,10 @@
  */
 #include <algorithm>
 #include <cassert>
+#include <vector>
+#include <stdint.h>
 #include <dali/dali.h>
+#include "rectangle-packer.h"
 
 /** Controls the output of application logging. */
 //#define DEBUG_PRINT_GRID_DIAGNOSTICS
@@ -29,6 +32,9 @@ namespace Demo
 {
 /**
  * @brief A 2D grid of booleans, settable and gettable via integer (x,y) coordinates.
+ *
+ * Each row is packed into 64 bit words, so a span of a row is tested or set with a
+ * mask per word it touches rather than cell by cell.
  * */
 class GridFlags
 {
@@ -36,7 +42,7 @@ public:
   /**
    * Create grid of specified dimensions.
    */
-  GridFlags( unsigned width, unsigned height ) :  mCells( width * height ), mWidth( width ), mHeight( height ), mHighestUsedRow( 0 )
+  GridFlags( unsigned width, unsigned height ) :  mWordsPerRow( ( width + BITS_PER_WORD - 1 ) / BITS_PER_WORD ), mCells( mWordsPerRow * height ), mWidth( width ), mHeight( height ), mHighestUsedRow( 0 ), mOverlapped( false ), mPacker( width, height )
   {
 #ifdef DEBUG_PRINT_GRID_DIAGNOSTICS
       fprintf(stderr, "Grid created with dimensions: (%u, %u).\n", mWidth, mHeight );
@@ -45,14 +51,52 @@ public:
 
   void Set( const unsigned x, const unsigned y )
   {
-    const unsigned index = CellIndex( x, y );
-    mCells[index] += 1u; ///< += To allow a debug check of the number of times a cell is set.
-    mHighestUsedRow = std::max( mHighestUsedRow, y );
+    SetRegion( x, y, 1u, 1u );
   }
 
   bool Get( unsigned x, unsigned y ) const
   {
-    return mCells[ CellIndex( x, y ) ] != 0;
+    return ( mCells[ WordIndex( x, y ) ] & ( Word( 1u ) << ( x % BITS_PER_WORD ) ) ) != 0u;
+  }
+
+  /**
+   * @brief Whether no cell of a rectangular region is set.
+   */
+  bool IsRegionFree( unsigned x, unsigned y, unsigned width, unsigned height ) const
+  {
+    for( unsigned row = y; row < y + height; ++row )
+    {
+      for( unsigned word = x / BITS_PER_WORD; word * BITS_PER_WORD < x + width; ++word )
+      {
+        if( mCells[ WordIndex( word * BITS_PER_WORD, row ) ] & SpanMask( word, x, x + width ) )
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Set every cell of a rectangular region.
+   */
+  void SetRegion( unsigned x, unsigned y, unsigned width, unsigned height )
+  {
+    if( width == 0u || height == 0u )
+    {
+      return;
+    }
+    for( unsigned row = y; row < y + height; ++row )
+    {
+      for( unsigned word = x / BITS_PER_WORD; word * BITS_PER_WORD < x + width; ++word )
+      {
+        Word& cells = mCells[ WordIndex( word * BITS_PER_WORD, row ) ];
+        const Word mask = SpanMask( word, x, x + width );
+        mOverlapped |= ( cells & mask ) != 0u; ///< To allow a debug check that no cell is set twice.
+        cells |= mask;
+      }
+    }
+    mHighestUsedRow = std::max( mHighestUsedRow, y + height - 1u );
   }
 
   unsigned GetHighestUsedRow() const
@@ -69,6 +113,7 @@ public:
    * @param[out] outRegion The rectangle actually found: the lowest-Y exact match region
    *             or the largest area rectangular region no greater than the requested
    *             region in x or y. Undefined if false is returned.
+   * @note Only regions allocated by this may be Set(), as the packer does not see other cells set.
    */
   bool AllocateRegion( const Vector2& region, unsigned& outCellX, unsigned& outCellY, Vector2& outRegion )
   {
@@ -77,71 +122,8 @@ public:
 #ifdef DEBUG_PRINT_GRID_DIAGNOSTICS
       fprintf( stderr, "Allocation requested for region (%u, %u). Result: ", regionWidth, regionHeight );
 #endif
-    unsigned bestRegionWidth = 0;
-    unsigned bestRegionHeight = 0;
-    unsigned bestCellX = 0;
-    unsigned bestCellY = 0;
-
-    // Look for a non-set cell:
-    for( unsigned y = 0; y < mHeight; ++y )
-    {
-      for( unsigned x = 0; x < mWidth; ++x )
-      {
-        if ( !Get( x, y) )
-        {
-          // Look for clear grid cells under the desired region:
-
-          const unsigned clampedRegionHeight = std::min( regionHeight, mHeight - y);
-          const unsigned clampedRegionWidth = std::min( regionWidth, mWidth - x);
-          const unsigned regionLimitY = y + clampedRegionHeight;
-          const unsigned regionLimitX = x + clampedRegionWidth;
-
-          for( unsigned regionY = y; regionY < regionLimitY; ++regionY )
-          {
-            for( unsigned regionX = x; regionX < regionLimitX; ++regionX )
-            {
-              if( Get( regionX, regionY ) )
-              {
-                // The region of clear cells is not big enough but remember it
-                // anyway in case there is no region that fits:
-                const unsigned clearRegionWidth = regionX - x;
-                const unsigned clearRegionHeight = (regionY + 1) - y;
-                if( clearRegionWidth * clearRegionHeight > bestRegionWidth * bestRegionHeight )
-                {
-                  bestCellX = x;
-                  bestCellY = y;
-                  bestRegionWidth = clearRegionWidth;
-                  bestRegionHeight = clearRegionHeight;
-                }
-                goto whole_region_not_found;
-              }
-            }
-          }
-
-          // Every cell in the region is clear so check if it is the best one yet:
-          if( clampedRegionWidth * clampedRegionHeight > bestRegionWidth * bestRegionHeight )
-          {
-            bestCellX = x;
-            bestCellY = y;
-            bestRegionWidth = clampedRegionWidth;
-            bestRegionHeight = clampedRegionHeight;
-          }
-
-          // If a big-enough region was found, end the search early and greedily allocate it:
-          if( clampedRegionHeight == regionHeight && clampedRegionWidth == regionWidth )
-          {
-            x = mWidth;
-            y = mHeight;
-          }
-whole_region_not_found:
-          continue;
-        }
-      }
-    }
-
-    // Allocate and return the best cell region found:
-
-    if( bestRegionWidth == 0 || bestRegionHeight == 0 )
+    RectanglePacker::Rect best;
+    if( !mPacker.Allocate( regionWidth, regionHeight, best ) )
     {
 #ifdef DEBUG_PRINT_GRID_DIAGNOSTICS
         fputs( "false.\n", stderr );
@@ -151,19 +133,14 @@ whole_region_not_found:
 
     // Allocate the found region:
 #ifdef DEBUG_PRINT_GRID_DIAGNOSTICS
-      fprintf( stderr, " - bestCellX = %u, bestCellY = %u, bestRegionWidth = %u, bestRegionHeight = %u - ", bestCellX, bestCellY, bestRegionWidth, bestRegionHeight );
+      fprintf( stderr, " - bestCellX = %u, bestCellY = %u, bestRegionWidth = %u, bestRegionHeight = %u - ", best.x, best.y, best.width, best.height );
 #endif
-    for( unsigned y = bestCellY; y < bestCellY + bestRegionHeight; ++y )
-    {
-      for( unsigned x = bestCellX; x < bestCellX + bestRegionWidth; ++x )
-      {
-        Set( x, y );
-      }
-    }
+    assert( IsRegionFree( best.x, best.y, best.width, best.height ) && "Packer allocated cells already set." );
+    SetRegion( best.x, best.y, best.width, best.height );
 
-    outCellX = bestCellX;
-    outCellY = bestCellY;
-    outRegion = Vector2( bestRegionWidth, bestRegionHeight );
+    outCellX = best.x;
+    outCellY = best.y;
+    outRegion = Vector2( best.width, best.height );
 #ifdef DEBUG_PRINT_GRID_DIAGNOSTICS
       fputs( "true.\n", stderr );
 #endif
@@ -173,28 +150,36 @@ whole_region_not_found:
   /** @return True if every cell was set one or zero times, else false. */
   bool DebugCheckGridValid()
   {
-    for( unsigned cell = 0; cell < mWidth * mHeight; ++cell )
-    {
-      if( mCells[cell] > 1 )
-      {
-        return false;
-      }
-    }
-    return true;
+    return !mOverlapped;
   }
 
 private:
-  unsigned CellIndex( unsigned x, unsigned y ) const
+  typedef uint64_t Word;
+  static const unsigned BITS_PER_WORD = 64u;
+
+  unsigned WordIndex( unsigned x, unsigned y ) const
   {
-    const unsigned offset = mWidth * y + x;
-    assert( offset < mCells.size() && "Out of range access to grid." );
+    const unsigned offset = mWordsPerRow * y + x / BITS_PER_WORD;
+    assert( x < mWidth && offset < mCells.size() && "Out of range access to grid." );
     return offset;
   }
 
-  std::vector<unsigned char> mCells;
+  /** @return The bits of a word of a row that lie in the span [begin, end) of that row. */
+  static Word SpanMask( unsigned word, unsigned begin, unsigned end )
+  {
+    const unsigned first = std::max( begin, word * BITS_PER_WORD ) - word * BITS_PER_WORD;
+    const unsigned last = std::min( end, ( word + 1u ) * BITS_PER_WORD ) - word * BITS_PER_WORD;
+    const Word ones = last - first < BITS_PER_WORD ? ( Word( 1u ) << ( last - first ) ) - 1u : ~Word( 0u );
+    return ones << first;
+  }
+
+  const unsigned mWordsPerRow;
+  std::vector<Word> mCells; ///< A bit per cell, each row starting on a new word
   const unsigned mWidth;
   const unsigned mHeight;
   unsigned mHighestUsedRow;
+  bool mOverlapped; ///< Whether any cell was set more than once
+  RectanglePacker mPacker; ///< Where the free regions are
 };
 
 } /* namespace Demo */
@@ -38,18 +38,25 @@
  * grid  using the button in the top-right of the toolbar.
  * A single image can be cycled by clicking the image directly.
  *
+ * Only the images in and near the part of the grid scrolled into view are
+ * created and loaded, and those scrolled well out of view are released, so
+ * the memory used does not grow with the number of images in the grid.
+ * A placeholder is shown in place of each image until it has loaded.
+ *
  * @see CreateImage CreateImageView
  */
 
 // EXTERNAL INCLUDES
 #include <algorithm>
 #include <map>
+#include <vector>
 #include <dali-toolkit/dali-toolkit.h>
 #include <iostream>
 
 // INTERNAL INCLUDES
 #include "grid-flags.h"
 #include "shared/view.h"
+#include "shared/launch-timing.h"
 
 using namespace Dali;
 using namespace Dali::Toolkit;
@@ -80,6 +87,14 @@ const float CELL_ASPECT_RATIO = 1.33333333333333333333f;
 
 const Dali::FittingMode::Type DEFAULT_SCALING_MODE = Dali::FittingMode::SCALE_TO_FILL;
 
+/** The colour shown in place of an image until it has loaded. */
+const Vector4 PLACEHOLDER_COLOR( 1.0f, 1.0f, 1.0f, 0.25f );
+
+/** How far beyond the viewport images are loaded, as a proportion of the viewport's size. */
+const float PREFETCH_MARGIN = 0.5f;
+/** How far beyond the viewport images are kept before being released, as a proportion of the viewport's size. */
+const float RELEASE_MARGIN = 1.5f;
+
 /** The number of times to spin an image on touching, each spin taking a second.*/
 const float SPIN_DURATION = 1.0f;
 
@@ -175,12 +190,12 @@ const unsigned NUM_IMAGE_PATHS = sizeof(IMAGE_PATHS) / sizeof(IMAGE_PATHS[0]) -
  * @param[in] height The height of the image in pixels.
  * @param[in] fittingMode The mode to use when scaling the image to fit the desired dimensions.
  */
-Image CreateImage(const std::string& filename, unsigned int width, unsigned int height, Dali::FittingMode::Type fittingMode )
+ResourceImage CreateImage(const std::string& filename, unsigned int width, unsigned int height, Dali::FittingMode::Type fittingMode )
 {
 #ifdef DEBUG_PRINT_DIAGNOSTICS
     fprintf( stderr, "CreateImage(%s, %u, %u, fittingMode=%u)\n", filename.c_str(), width, height, unsigned( fittingMode ) );
 #endif
-  Image image = ResourceImage::New( filename, ImageDimensions( width, height ), fittingMode, Dali::SamplingMode::BOX_THEN_LINEAR );
+  ResourceImage image = ResourceImage::New( filename, ImageDimensions( width, height ), fittingMode, Dali::SamplingMode::BOX_THEN_LINEAR );
 
   return image;
 }
@@ -189,14 +204,11 @@ Image CreateImage(const std::string& filename, unsigned int width, unsigned int
  * Creates an ImageView
  *
  * @param[in] filename The path of the image.
- * @param[in] width The width of the image in pixels.
- * @param[in] height The height of the image in pixels.
- * @param[in] fittingMode The mode to use when scaling the image to fit the desired dimensions.
+ * @param[in] image The image created from the path with CreateImage.
  */
-ImageView CreateImageView(const std::string& filename, unsigned int width, unsigned int height, Dali::FittingMode::Type fittingMode )
+ImageView CreateImageView(const std::string& filename, const Image& image )
 {
-  Image img = CreateImage( filename, width, height, fittingMode );
-  ImageView actor = ImageView::New( img );
+  ImageView actor = ImageView::New( image );
   actor.SetName( filename );
   actor.SetParentOrigin(ParentOrigin::CENTER);
   actor.SetAnchorPoint(AnchorPoint::CENTER);
@@ -257,6 +269,51 @@ struct PositionedImage
   Vector2 imageGridDims;
 };
 
+/**
+ * An image of the field, which has an ImageView only while it is near the viewport.
+ */
+struct GridImage
+{
+  GridImage( const char * const path, const Vector2& position, const Vector2& size, Dali::FittingMode::Type fittingMode ) :
+    path( path ),
+    position( position ),
+    size( size ),
+    fittingMode( fittingMode )
+  {}
+
+  float Top() const
+  {
+    return position.y - size.y * 0.5f;
+  }
+
+  /** @return True if the image overlaps the rectangle between the corners given. */
+  bool Intersects( const Vector2& topLeft, const Vector2& bottomRight ) const
+  {
+    const Vector2 halfSize = size * 0.5f;
+    return position.x + halfSize.x > topLeft.x && position.x - halfSize.x < bottomRight.x &&
+           position.y + halfSize.y > topLeft.y && position.y - halfSize.y < bottomRight.y;
+  }
+
+  const char * path;
+  Vector2 position;                     ///< The centre of the image in the grid actor's frame.
+  Vector2 size;
+  Dali::FittingMode::Type fittingMode;  ///< The current scaling mode of the image.
+  ImageView view;                       ///< Empty unless the image is loaded.
+  ResourceImage image;                  ///< The image being shown by the view.
+};
+
+/** Orders images top to bottom. */
+bool IsAbove( const GridImage& a, const GridImage& b )
+{
+  return a.Top() < b.Top();
+}
+
+/** Compares an image's top edge with a y coordinate. */
+bool IsTopAbove( const GridImage& image, float y )
+{
+  return image.Top() < y;
+}
+
 }
 
 /**
@@ -268,7 +325,8 @@ public:
 
   ImageScalingIrregularGridController( Application& application )
   : mApplication( application ),
-    mScrolling( false )
+    mScrolling( false ),
+    mTallestImage( 0.0f )
   {
     std::cout << "ImageScalingIrregularGridController::ImageScalingIrregularGridController" << std::endl;
 
@@ -333,6 +391,7 @@ public:
 
     mScrollView.ScrollStartedSignal().Connect( this, &ImageScalingIrregularGridController::OnScrollStarted );
     mScrollView.ScrollCompletedSignal().Connect( this, &ImageScalingIrregularGridController::OnScrollCompleted );
+    mScrollView.ScrollUpdatedSignal().Connect( this, &ImageScalingIrregularGridController::OnScrollUpdated );
 
     mScrollView.SetAnchorPoint(AnchorPoint::CENTER);
     mScrollView.SetParentOrigin(ParentOrigin::CENTER);
@@ -349,7 +408,8 @@ public:
     mScrollView.SetRulerX ( rulerX );
 
     RulerPtr rulerY = new DefaultRuler(); //< Snap in multiples of a screen / stage height
-    rulerY->SetDomain( RulerDomain( - fieldHeight * 0.5f + stageSize.height * 0.5f - GRID_CELL_PADDING, fieldHeight * 0.5f + stageSize.height * 0.5f + GRID_CELL_PADDING ) );
+    const float scrollTop = - fieldHeight * 0.5f + stageSize.height * 0.5f - GRID_CELL_PADDING;
+    rulerY->SetDomain( RulerDomain( scrollTop, fieldHeight * 0.5f + stageSize.height * 0.5f + GRID_CELL_PADDING ) );
     mScrollView.SetRulerY ( rulerY );
 
     mContentLayer.Add( mScrollView );
@@ -373,20 +433,25 @@ public:
 
     mScrollView.OnRelayoutSignal().Connect( this, &ImageScalingIrregularGridController::OnScrollViewRelayout );
 
-    // Scroll to top of grid so first images loaded are on-screen:
+    // Scroll to top of grid and load the images there first:
+    mViewportSize = stageSize;
     mScrollView.ScrollTo( Vector2( 0, -1000000 ) );
+    UpdateLoadedImages( Vector2( 0, scrollTop ) );
   }
 
   void OnScrollViewRelayout(Actor actor)
   {
     // Make the height of the horizontal scroll bar to be the same as the width of scroll view.
     mScrollBarHorizontal.SetSize(Vector2(0.0f, mScrollView.GetRelayoutSize( Dimension::WIDTH) ));
+
+    // The images loaded follow it from the next scroll:
+    mViewportSize = Vector2( mScrollView.GetRelayoutSize( Dimension::WIDTH ), mScrollView.GetRelayoutSize( Dimension::HEIGHT ) );
   }
 
   /**
    * Build a field of images scaled into a variety of shapes from very wide,
-   * through square, to very tall. The images are direct children of the Dali::Actor
-   * returned.
+   * through square, to very tall. The images are laid out in mImages, and
+   * UpdateLoadedImages() adds them to the Dali::Actor returned as they come into view.
    **/
   Actor BuildImageField( const float fieldWidth,
                            const unsigned gridWidth,
@@ -450,7 +515,10 @@ public:
     outFieldHeight = actualGridHeight * cellHeight;
     const Vector2 gridOrigin = Vector2( -fieldWidth * 0.5f, -outFieldHeight * 0.5 );
 
-    // Build the image actors in their right locations in their parent's frame:
+    // Work out the locations of the images in their parent's frame:
+    mImages.clear();
+    mImages.reserve( placedImages.size() );
+    mTallestImage = 0.0f;
     for( std::vector<PositionedImage>::const_iterator i = placedImages.begin(), end = placedImages.end(); i != end; ++i )
     {
       const PositionedImage& imageSource = *i;
@@ -458,20 +526,122 @@ public:
       const Vector2 imageRegionCorner = gridOrigin + cellSize * Vector2( imageSource.cellX, imageSource.cellY );
       const Vector2 imagePosition = imageRegionCorner + Vector2( GRID_CELL_PADDING , GRID_CELL_PADDING ) + imageSize * 0.5f;
 
-      ImageView image = CreateImageView( imageSource.configuration.path, imageSize.x, imageSize.y, fittingMode );
-      image.SetPosition( Vector3( imagePosition.x, imagePosition.y, 0 ) );
-      image.SetSize( imageSize );
-      image.TouchSignal().Connect( this, &ImageScalingIrregularGridController::OnTouchImage );
-      mFittingModes[image.GetId()] = fittingMode;
-      mResourceUrls[image.GetId()] = imageSource.configuration.path;
-      mSizes[image.GetId()] = imageSize;
-
-      gridActor.Add( image );
+      mImages.push_back( GridImage( imageSource.configuration.path, imagePosition, imageSize, fittingMode ) );
+      mTallestImage = std::max( mTallestImage, imageSize.y );
     }
 
+    // Sorted so the images near a scroll position can be found without visiting the others:
+    std::stable_sort( mImages.begin(), mImages.end(), IsAbove );
+
     return gridActor;
   }
 
+  /**
+   * Load the images that are within the prefetch margin of the viewport and release
+   * those that have moved beyond the release margin.
+   * @param[in] scrollPosition The scroll position, which is the centre of the viewport in the grid actor's frame.
+   */
+  void UpdateLoadedImages( const Vector2& scrollPosition )
+  {
+    const Vector2 releaseMargin = mViewportSize * ( 0.5f + RELEASE_MARGIN );
+    const Vector2 releaseTopLeft = scrollPosition - releaseMargin;
+    const Vector2 releaseBottomRight = scrollPosition + releaseMargin;
+
+    // Only the loaded images are visited to find those to release:
+    std::vector<unsigned>::iterator kept = mLoadedImages.begin();
+    for( std::vector<unsigned>::iterator i = mLoadedImages.begin(), end = mLoadedImages.end(); i != end; ++i )
+    {
+      GridImage& image = mImages[*i];
+      if( image.Intersects( releaseTopLeft, releaseBottomRight ) )
+      {
+        *kept++ = *i;
+      }
+      else
+      {
+        ReleaseImage( image );
+      }
+    }
+    mLoadedImages.erase( kept, mLoadedImages.end() );
+
+    // Only the images with a top edge close enough to reach the prefetch area are visited to find those to load:
+    const Vector2 prefetchMargin = mViewportSize * ( 0.5f + PREFETCH_MARGIN );
+    const Vector2 prefetchTopLeft = scrollPosition - prefetchMargin;
+    const Vector2 prefetchBottomRight = scrollPosition + prefetchMargin;
+
+    std::vector<GridImage>::iterator first = std::lower_bound( mImages.begin(), mImages.end(), prefetchTopLeft.y - mTallestImage, IsTopAbove );
+    for( std::vector<GridImage>::iterator i = first, end = mImages.end(); i != end && i->Top() < prefetchBottomRight.y; ++i )
+    {
+      if( !i->view && i->Intersects( prefetchTopLeft, prefetchBottomRight ) )
+      {
+        LoadImage( *i );
+        mLoadedImages.push_back( i - mImages.begin() );
+      }
+    }
+  }
+
+  /**
+   * Create the view of an image and start loading it.
+   */
+  void LoadImage( GridImage& image )
+  {
+    image.image = CreateImage( image.path, image.size.width + 0.5f, image.size.height + 0.5f, image.fittingMode );
+    image.view = CreateImageView( image.path, image.image );
+    image.view.SetPosition( Vector3( image.position.x, image.position.y, 0 ) );
+    image.view.SetSize( image.size );
+    image.view.TouchSignal().Connect( this, &ImageScalingIrregularGridController::OnTouchImage );
+    ShowPlaceholder( image );
+
+    mImageIndices[image.view.GetId()] = &image - &mImages[0];
+    mGridActor.Add( image.view );
+  }
+
+  /**
+   * Show the placeholder until the image has loaded.
+   */
+  void ShowPlaceholder( GridImage& image )
+  {
+    if( image.image.GetLoadingState() == ResourceLoading )
+    {
+      image.view.SetBackgroundColor( PLACEHOLDER_COLOR );
+      image.image.LoadingFinishedSignal().Connect( this, &ImageScalingIrregularGridController::OnImageLoaded );
+    }
+    else
+    {
+      image.view.ClearBackground();
+    }
+  }
+
+  /**
+   * Remove the view of an image and drop the image, freeing its pixels.
+   */
+  void ReleaseImage( GridImage& image )
+  {
+    mImageIndices.erase( image.view.GetId() );
+    image.view.Unparent();
+    image.view.Reset();
+    image.image.Reset();
+  }
+
+  /**
+   * Clear the placeholder of an image that has loaded. An image that fails to load keeps it.
+   */
+  void OnImageLoaded( ResourceImage loadedImage )
+  {
+    if( loadedImage.GetLoadingState() != ResourceLoadingSucceeded )
+    {
+      return;
+    }
+    for( std::vector<unsigned>::const_iterator i = mLoadedImages.begin(), end = mLoadedImages.end(); i != end; ++i )
+    {
+      GridImage& image = mImages[*i];
+      if( image.image == loadedImage )
+      {
+        image.view.ClearBackground();
+        break;
+      }
+    }
+  }
+
  /**
   * Upon Touching an image (Release), change its scaling mode and make it spin, provided we're not scrolling.
   * @param[in] actor The actor touched
@@ -489,18 +659,13 @@ public:
         animation.Play();
 
         // Change the scaling mode:
-        const unsigned id = actor.GetId();
-        Dali::FittingMode::Type newMode = NextMode( mFittingModes[id] );
-        const Vector2 imageSize = mSizes[actor.GetId()];
-
-        const std::string& url = mResourceUrls[id];
-        Image newImage = CreateImage( url, imageSize.width + 0.5f, imageSize.height + 0.5f, newMode );
-        ImageView imageView = ImageView::DownCast( actor );
-        if(imageView)
+        std::map<unsigned, unsigned>::const_iterator index = mImageIndices.find( actor.GetId() );
+        if( index != mImageIndices.end() )
         {
-          imageView.SetImage( newImage );
+          GridImage& image = mImages[index->second];
+          image.fittingMode = NextMode( image.fittingMode );
+          ReloadImage( image );
         }
-        mFittingModes[id] = newMode;
       }
     }
     return false;
@@ -529,29 +694,35 @@ public:
   */
   bool OnToggleScalingTouched( Button button )
   {
-    const unsigned numChildren = mGridActor.GetChildCount();
-
-    for( unsigned i = 0; i < numChildren; ++i )
+    // Cycle the scaling mode options. Only the loaded images are reloaded, the others use their new mode when they come into view:
+    Dali::FittingMode::Type newMode = DEFAULT_SCALING_MODE;
+    for( std::vector<GridImage>::iterator image = mImages.begin(), end = mImages.end(); image != end; ++image )
     {
-      ImageView gridImageView = ImageView::DownCast( mGridActor.GetChildAt( i ) );
-      if( gridImageView )
+      newMode = NextMode( image->fittingMode );
+      image->fittingMode = newMode;
+      if( image->view )
       {
-        // Cycle the scaling mode options:
-        unsigned int id = gridImageView.GetId();
-
-        const Vector2 imageSize = mSizes[ id ];
-        Dali::FittingMode::Type newMode = NextMode( mFittingModes[ id ] );
-        Image newImage = CreateImage( mResourceUrls[ id ], imageSize.width, imageSize.height, newMode );
-        gridImageView.SetImage( newImage );
-
-        mFittingModes[ id ] = newMode;
-
-        SetTitle( std::string( newMode == FittingMode::SHRINK_TO_FIT ? "SHRINK_TO_FIT" : newMode == FittingMode::SCALE_TO_FILL ?  "SCALE_TO_FILL" : newMode == FittingMode::FIT_WIDTH ? "FIT_WIDTH" : "FIT_HEIGHT" ) );
+        ReloadImage( *image );
       }
     }
+
+    if( !mImages.empty() )
+    {
+      SetTitle( std::string( newMode == FittingMode::SHRINK_TO_FIT ? "SHRINK_TO_FIT" : newMode == FittingMode::SCALE_TO_FILL ?  "SCALE_TO_FILL" : newMode == FittingMode::FIT_WIDTH ? "FIT_WIDTH" : "FIT_HEIGHT" ) );
+    }
     return true;
   }
 
+  /**
+   * Load a loaded image again with its current scaling mode.
+   */
+  void ReloadImage( GridImage& image )
+  {
+    image.image = CreateImage( image.path, image.size.width + 0.5f, image.size.height + 0.5f, image.fittingMode );
+    image.view.SetImage( image.image );
+    ShowPlaceholder( image );
+  }
+
   /**
    * Sets/Updates the title of the View
    * @param[in] title The new title for the view.
@@ -586,6 +757,16 @@ public:
   void OnScrollCompleted( const Vector2& position )
   {
     mScrolling = false;
+    UpdateLoadedImages( position );
+  }
+
+  /**
+   * As the scrollview scrolls, load the images coming into view and release those left behind.
+   * @param[in] position Current Scroll Position
+   */
+  void OnScrollUpdated( const Vector2& position )
+  {
+    UpdateLoadedImages( position );
   }
 
 private:
@@ -600,9 +781,11 @@ private:
   ScrollBar mScrollBarVertical;
   ScrollBar mScrollBarHorizontal;
   bool mScrolling;                    ///< ScrollView scrolling state (true = scrolling, false = stationary)
-  std::map<unsigned, Dali::FittingMode::Type> mFittingModes; ///< Stores the current scaling mode of each image, keyed by image actor id.
-  std::map<unsigned, std::string> mResourceUrls; ///< Stores the url of each image, keyed by image actor id.
-  std::map<unsigned, Vector2> mSizes; ///< Stores the current size of each image, keyed by image actor id.
+  Vector2 mViewportSize;              ///< The size of the ScrollView
+  std::vector<GridImage> mImages;     ///< Every image of the field, sorted by top edge.
+  float mTallestImage;                ///< The height of the tallest image, which bounds how far above a point an image reaching it starts.
+  std::vector<unsigned> mLoadedImages; ///< The indices in mImages of the images with a view.
+  std::map<unsigned, unsigned> mImageIndices; ///< The index in mImages of each loaded image, keyed by image actor id.
 };
 
 void RunTest( Application& application )
@@ -616,6 +799,7 @@ void RunTest( Application& application )
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv, DEMO_THEME_PATH );
+  DemoHelper::ReportLaunchTiming( application );
 
   RunTest( application );
 
@@ -0,0 +1,202 @@
+#ifndef __DALI_DEMO_RECTANGLE_PACKER_H_
+#define __DALI_DEMO_RECTANGLE_PACKER_H_
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <algorithm>
+#include <vector>
+
+namespace Dali
+{
+namespace Demo
+{
+/**
+ * @brief Packs rectangles into an area of whole cells.
+ *
+ * The free space is kept as the list of maximal free rectangles: every free
+ * rectangle that cannot be grown in any direction. Any free region lies within
+ * one of them, so a request is answered by looking at each of them once rather
+ * than at each cell, and the list stays short as it only grows with the number
+ * of holes left between the rectangles placed.
+ */
+class RectanglePacker
+{
+public:
+  struct Rect
+  {
+    Rect() : x( 0 ), y( 0 ), width( 0 ), height( 0 ) {}
+    Rect( unsigned x, unsigned y, unsigned width, unsigned height ) : x( x ), y( y ), width( width ), height( height ) {}
+
+    unsigned Right() const { return x + width; }
+    unsigned Bottom() const { return y + height; }
+
+    bool Intersects( const Rect& other ) const
+    {
+      return x < other.Right() && other.x < Right() && y < other.Bottom() && other.y < Bottom();
+    }
+
+    bool Contains( const Rect& other ) const
+    {
+      return x <= other.x && y <= other.y && other.Right() <= Right() && other.Bottom() <= Bottom();
+    }
+
+    /** True if this is above, or level with and to the left of, the other. */
+    bool IsBefore( const Rect& other ) const
+    {
+      return y < other.y || ( y == other.y && x < other.x );
+    }
+
+    unsigned x;
+    unsigned y;
+    unsigned width;
+    unsigned height;
+  };
+
+  /**
+   * @brief Create a packer for an empty area of the specified dimensions.
+   */
+  RectanglePacker( unsigned width, unsigned height )
+  {
+    if( width > 0 && height > 0 )
+    {
+      mFreeRects.push_back( Rect( 0, 0, width, height ) );
+    }
+  }
+
+  /**
+   * @brief Allocate a region for a rectangle.
+   *
+   * The region is the highest placement of the whole rectangle (the leftmost of those
+   * in the same row), or if it fits nowhere, the largest area free region no wider and
+   * no taller than the rectangle.
+   *
+   * @param[in] width The width of the rectangle requested.
+   * @param[in] height The height of the rectangle requested.
+   * @param[out] outRect The region allocated. Undefined if false is returned.
+   * @return true if a region was allocated, false if there is no free space left.
+   */
+  bool Allocate( unsigned width, unsigned height, Rect& outRect )
+  {
+    const Rect* exact = NULL;
+    const Rect* largest = NULL;
+    unsigned largestArea = 0;
+
+    for( std::vector<Rect>::const_iterator free = mFreeRects.begin(), end = mFreeRects.end(); free != end; ++free )
+    {
+      if( free->width >= width && free->height >= height )
+      {
+        if( !exact || free->IsBefore( *exact ) )
+        {
+          exact = &*free;
+        }
+      }
+      else if( !exact )
+      {
+        const unsigned area = std::min( free->width, width ) * std::min( free->height, height );
+        if( area > largestArea || ( area == largestArea && largest && free->IsBefore( *largest ) ) )
+        {
+          largest = &*free;
+          largestArea = area;
+        }
+      }
+    }
+
+    if( exact )
+    {
+      outRect = Rect( exact->x, exact->y, width, height );
+    }
+    else if( largest && largestArea > 0 )
+    {
+      outRect = Rect( largest->x, largest->y, std::min( largest->width, width ), std::min( largest->height, height ) );
+    }
+    else
+    {
+      return false;
+    }
+
+    Place( outRect );
+    return true;
+  }
+
+private:
+  /**
+   * @brief Remove a rectangle from the free space, splitting the free rectangles it overlaps.
+   */
+  void Place( const Rect& placed )
+  {
+    std::vector<Rect> freeRects;
+    freeRects.reserve( mFreeRects.size() + 4 );
+    std::vector<Rect> splits;
+
+    for( std::vector<Rect>::const_iterator free = mFreeRects.begin(), end = mFreeRects.end(); free != end; ++free )
+    {
+      if( !free->Intersects( placed ) )
+      {
+        freeRects.push_back( *free );
+        continue;
+      }
+
+      // The maximal free rectangles left of, right of, above and below the placed one:
+      if( placed.x > free->x )
+      {
+        splits.push_back( Rect( free->x, free->y, placed.x - free->x, free->height ) );
+      }
+      if( placed.Right() < free->Right() )
+      {
+        splits.push_back( Rect( placed.Right(), free->y, free->Right() - placed.Right(), free->height ) );
+      }
+      if( placed.y > free->y )
+      {
+        splits.push_back( Rect( free->x, free->y, free->width, placed.y - free->y ) );
+      }
+      if( placed.Bottom() < free->Bottom() )
+      {
+        splits.push_back( Rect( free->x, placed.Bottom(), free->width, free->Bottom() - placed.Bottom() ) );
+      }
+    }
+
+    // Drop the splits that are within another free rectangle. The rectangles that were not
+    // split were maximal before, so cannot be within a split, which is within a rectangle
+    // they were not within.
+    const size_t keptCount = freeRects.size();
+    for( size_t i = 0; i < splits.size(); ++i )
+    {
+      bool contained = false;
+      for( size_t j = 0; j < keptCount && !contained; ++j )
+      {
+        contained = freeRects[j].Contains( splits[i] );
+      }
+      for( size_t j = 0; j < splits.size() && !contained; ++j )
+      {
+        // Of identical splits, only the first is kept:
+        contained = j != i && splits[j].Contains( splits[i] ) && ( j < i || !splits[i].Contains( splits[j] ) );
+      }
+      if( !contained )
+      {
+        freeRects.push_back( splits[i] );
+      }
+    }
+
+    mFreeRects.swap( freeRects );
+  }
+
+  std::vector<Rect> mFreeRects; ///< The maximal free rectangles
+};
+
+} /* namespace Demo */
+} /* namespace Dali */
+
+#endif /* __DALI_DEMO_RECTANGLE_PACKER_H_ */
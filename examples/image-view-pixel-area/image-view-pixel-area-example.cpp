@@ -17,6 +17,7 @@
 
 #include <dali-toolkit/dali-toolkit.h>
 #include "shared/view.h"
+#include "shared/launch-timing.h"
 
 using namespace Dali;
 
@@ -244,6 +245,7 @@ void RunTest( Application& application )
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv );
+  DemoHelper::ReportLaunchTiming( application );
 
   RunTest( application );
 
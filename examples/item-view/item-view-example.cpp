@@ -17,6 +17,7 @@
 
 #include <sstream>
 #include "shared/view.h"
+#include "shared/launch-timing.h"
 
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
@@ -1003,6 +1004,7 @@ void RunTest(Application& app)
 int DALI_EXPORT_API main(int argc, char **argv)
 {
   Application app = Application::New(&argc, &argv, DEMO_THEME_PATH);
+  DemoHelper::ReportLaunchTiming( app );
 
   RunTest(app);
 
@@ -21,6 +21,7 @@
 
 // INTERNAL INCLUDES
 #include "shared/view.h"
+#include "shared/launch-timing.h"
 
 #include <sstream>
 
@@ -390,6 +391,7 @@ void RunTest( Application& application )
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv );
+  DemoHelper::ReportLaunchTiming( application );
 
   RunTest( application );
 
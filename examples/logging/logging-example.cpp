@@ -16,6 +16,7 @@
  */
 
 #include "shared/view.h"
+#include "shared/launch-timing.h"
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali/devel-api/adaptor-framework/performance-logger.h>
@@ -684,6 +685,7 @@ void RunTest( Application& application )
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv, DEMO_THEME_PATH );
+  DemoHelper::ReportLaunchTiming( application );
 
   RunTest( application );
 
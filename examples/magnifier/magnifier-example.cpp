@@ -19,6 +19,7 @@
 
 // INTERNAL INCLUDES
 #include "shared/view.h"
+#include "shared/launch-timing.h"
 
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali-toolkit/devel-api/controls/magnifier/magnifier.h>
@@ -413,6 +414,7 @@ void RunTest( Application& application )
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv, DEMO_THEME_PATH );
+  DemoHelper::ReportLaunchTiming( application );
 
   RunTest( application );
 
@@ -25,6 +25,7 @@
 // INTERNAL INCLUDES
 #include "shared/view.h"
 #include "shared/utility.h"
+#include "shared/launch-timing.h"
 
 using namespace Dali;
 
@@ -308,6 +309,7 @@ void RunTest( Application& application )
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv );
+  DemoHelper::ReportLaunchTiming( application );
 
   RunTest( application );
 
@@ -1,5 +1,6 @@
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali/public-api/object/property-map.h>
+#include "shared/launch-timing.h"
 
 using namespace Dali;
 using namespace Dali::Toolkit;
@@ -601,9 +602,10 @@ private:
 
 // Entry point for Linux & Tizen applications
 //
-int main( int argc, char **argv )
+int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv );
+  DemoHelper::ReportLaunchTiming( application );
   MeshVisualController test( application );
   application.MainLoop();
   return 0;
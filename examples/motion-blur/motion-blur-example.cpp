@@ -19,6 +19,7 @@
 #include <iomanip>
 
 #include "shared/view.h"
+#include "shared/launch-timing.h"
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali-toolkit/devel-api/shader-effects/motion-blur-effect.h>
@@ -554,6 +555,7 @@ void RunTest(Application& app)
 int DALI_EXPORT_API main(int argc, char **argv)
 {
   Application app = Application::New(&argc, &argv, DEMO_THEME_PATH);
+  DemoHelper::ReportLaunchTiming( app );
 
   RunTest(app);
 
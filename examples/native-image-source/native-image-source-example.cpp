@@ -25,6 +25,7 @@
 
 // INTERNAL INCLUDES
 #include "shared/utility.h"
+#include "shared/launch-timing.h"
 
 using namespace Dali;
 using namespace Toolkit;
@@ -301,6 +302,7 @@ void RunTest( Application& application )
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv );
+  DemoHelper::ReportLaunchTiming( application );
 
   RunTest( application );
 
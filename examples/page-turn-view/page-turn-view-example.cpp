@@ -30,6 +30,7 @@
 
 #include "shared/view.h"
 #include "shared/utility.h"
+#include "shared/launch-timing.h"
 
 using namespace Dali;
 using namespace Dali::Toolkit;
@@ -370,6 +371,7 @@ void PageTurnController::OnPageFinishedPan( PageTurnView pageTurnView )
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application app = Application::New(&argc, &argv, DEMO_THEME_PATH);
+  DemoHelper::ReportLaunchTiming( app );
   PageTurnController test ( app );
 
   app.MainLoop();
@@ -19,6 +19,11 @@
 #include <dali-toolkit/dali-toolkit.h>
 
 #include "shared/utility.h"
+#include "shared/async-texture-loader.h"
+#include "shared/frame-timing-recorder.h"
+#include "shared/headless.h"
+#include "shared/benchmark-compare.h"
+#include "shared/launch-timing.h"
 
 using namespace Dali;
 using namespace Dali::Toolkit;
@@ -187,14 +192,29 @@ unsigned int gRowsPerPage(15);
 unsigned int gColumnsPerPage(15);
 unsigned int gPageCount(10);
 float gDuration(10.0f);
+std::string gReportPath;
+bool gHeadless(false);
+unsigned int gFrameStep(16);
+std::string gSweep;
+std::string gFrameTimesPath;
+std::string gBaselinePath;
+std::string gSaveBaselinePath;
+DemoHelper::RegressionOptions gRegressionOptions;
+
+const DemoHelper::SweepOption SWEEP_OPTIONS[] = {
+                                                  { "rows", "-r" },
+                                                  { "columns", "-c" },
+                                                  { "pages", "-p" },
+};
+const unsigned int NUM_SWEEP_OPTIONS = sizeof(SWEEP_OPTIONS) / sizeof(SWEEP_OPTIONS[0]);
 
-Renderer CreateRenderer( unsigned int index, Geometry geometry, Shader shader )
+Renderer CreateRenderer( unsigned int index, Geometry geometry, Shader shader, CallbackBase* loadedCallback )
 {
   Renderer renderer = Renderer::New( geometry, shader );
   const char* imagePath = !gNinePatch ? IMAGE_PATH[index] : NINEPATCH_IMAGE_PATH[index];
-  Texture texture = DemoHelper::LoadTexture( imagePath );
+  // Decoded on the worker threads; the texture is set once it has been uploaded.
   TextureSet textureSet = TextureSet::New();
-  textureSet.SetTexture( 0u, texture );
+  DemoHelper::LoadTextureAsync( imagePath, textureSet, 0u, loadedCallback );
   renderer.SetTextures( textureSet );
   renderer.SetProperty( Renderer::Property::BLEND_MODE, BlendMode::OFF );
   return renderer;
@@ -205,8 +225,20 @@ Renderer CreateRenderer( unsigned int index, Geometry geometry, Shader shader )
 // Test application to compare performance between ImageActor and ImageView
 // By default, the application consist of 10 pages of 25x25 ImageActors, this can be modified using the following command line arguments:
 // -t duration (sec )
+// -r NumberOfRows  (Modifies the number of rows per page)
+// -c NumberOfColumns (Modifies the number of columns per page)
+// -p NumberOfPages (Modifies the number of pages )
 // --use-imageview ( Use ImageView instead of ImageActor )
 // --use-mesh ( Use new renderer API (as ImageView) but shares renderers between actors when possible )
+// --headless ( Renders offscreen, ignores touch and advances the animations by a fixed step per rendered frame )
+// --frame-step=Milliseconds ( The fixed step used by --headless, 16ms by default )
+// --sweep=Specification ( Runs every combination of e.g. "rows=5..50:5,pages=1..20" in a fresh process and writes a scaling table to the report instead )
+// --frame-times=FileName ( Writes the duration of every frame to FileName )
+// --save-baseline=FileName ( Runs the test --runs times in fresh processes and saves the pooled frame times as a baseline )
+// --baseline=FileName ( Runs the test --runs times in fresh processes and fails if it is significantly slower than the baseline )
+// --runs=N ( Number of runs for --save-baseline and --baseline, 5 by default )
+// --max-regression=Percent ( Allowed growth of the p95 frame time for --baseline, 5% by default )
+// --report=FileName ( Writes the frame timing report to FileName, as CSV if it ends in ".csv" and JSON otherwise. Defaults to the standard output )
 
 //
 class PerfScroll : public ConnectionTracker
@@ -217,7 +249,9 @@ public:
   : mApplication( application ),
   mRowsPerPage( gRowsPerPage ),
   mColumnsPerPage( gColumnsPerPage ),
-  mPageCount( gPageCount )
+  mPageCount( gPageCount ),
+  mPendingTextures( 0u ),
+  mActorsCreated( false )
   {
     // Connect to the Application's Init signal
     mApplication.InitSignal().Connect( this, &PerfScroll::Create );
@@ -240,13 +274,23 @@ public:
 
     mSize = Vector3( stageSize.x / mColumnsPerPage, stageSize.y / mRowsPerPage, 0.0f );
 
-    // Respond to a click anywhere on the stage
-    stage.GetRootLayer().TouchSignal().Connect( this, &PerfScroll::OnTouch );
+    if( gHeadless )
+    {
+      DemoHelper::RenderOffscreen();
+      mClock.Enable( gFrameStep );
+    }
+    else
+    {
+      // Respond to a click anywhere on the stage
+      stage.GetRootLayer().TouchSignal().Connect( this, &PerfScroll::OnTouch );
+    }
 
     mParent = Actor::New();
     mParent.SetAnchorPoint( AnchorPoint::TOP_LEFT );
     stage.Add(mParent);
 
+    mFrameTimingRecorder.SampleMemory( "start" );
+
     if( gUseMesh )
     {
       CreateMeshActors();
@@ -255,6 +299,44 @@ public:
     {
       CreateImageViews();
     }
+    mActorsCreated = true;
+
+    // The textures decoded on the worker threads are part of creating the actors, so the
+    // "create" sample and the "show" phase wait for them.
+    if( mPendingTextures == 0u )
+    {
+      StartShow();
+    }
+  }
+
+  /**
+   * @brief Called once each texture loaded in the background has been set.
+   */
+  void OnTextureLoaded()
+  {
+    --mPendingTextures;
+    if( mPendingTextures == 0u && mActorsCreated )
+    {
+      StartShow();
+    }
+  }
+
+  /**
+   * @brief Starts the timed phases, once the actors and their textures are ready.
+   */
+  void StartShow()
+  {
+    mFrameTimingRecorder.SampleMemory( "create", mRowsPerPage * mColumnsPerPage * mPageCount );
+
+    mFrameTimingRecorder.AddParameter( "test", "perf-scroll" );
+    mFrameTimingRecorder.AddParameter( "mode", gUseMesh ? "mesh" : "image-view" );
+    mFrameTimingRecorder.AddParameter( "ninePatch", gNinePatch ? "true" : "false" );
+    mFrameTimingRecorder.AddParameter( "rows", mRowsPerPage );
+    mFrameTimingRecorder.AddParameter( "columns", mColumnsPerPage );
+    mFrameTimingRecorder.AddParameter( "pages", mPageCount );
+    mFrameTimingRecorder.AddParameter( "actors", mRowsPerPage * mColumnsPerPage * mPageCount );
+    mFrameTimingRecorder.AddParameter( "headless", gHeadless ? "true" : "false" );
+    mFrameTimingRecorder.Start( "show" );
 
     ShowAnimation();
   }
@@ -262,10 +344,28 @@ public:
   bool OnTouch( Actor actor, const TouchData& touch )
   {
     // quit the application
-    mApplication.Quit();
+    Quit();
     return true;
   }
 
+  void Quit()
+  {
+    mFrameTimingRecorder.Stop();
+    mApplication.Quit();
+  }
+
+  /**
+   * @brief Writes the frame timing report, once the main loop has finished.
+   */
+  void WriteReport()
+  {
+    mFrameTimingRecorder.WriteReport( gReportPath );
+    if( !gFrameTimesPath.empty() )
+    {
+      mFrameTimingRecorder.WriteFrameTimes( gFrameTimesPath );
+    }
+  }
+
   const char* ImagePath( int i )
   {
     return !gNinePatch ? IMAGE_PATH[i % NUM_IMAGES] : NINEPATCH_IMAGE_PATH[i % NUM_NINEPATCH_IMAGES];
@@ -296,7 +396,8 @@ public:
     Geometry geometry = DemoHelper::CreateTexturedQuad();
     for( unsigned int i(0); i<numImages; ++i )
     {
-      renderers[i] = CreateRenderer( i, geometry, shader );
+      ++mPendingTextures;
+      renderers[i] = CreateRenderer( i, geometry, shader, MakeCallback( this, &PerfScroll::OnTextureLoaded ) );
     }
 
     //Create the actors
@@ -316,15 +417,18 @@ public:
   {
     if( source == mShow )
     {
+      mFrameTimingRecorder.SampleMemory( "show" );
       ScrollAnimation();
     }
     else if( source == mScroll )
     {
+      mFrameTimingRecorder.SampleMemory( "scroll" );
       HideAnimation();
     }
     else
     {
-      mApplication.Quit();
+      mFrameTimingRecorder.SampleMemory( "hide" );
+      Quit();
     }
   }
 
@@ -378,7 +482,7 @@ public:
         ++count;
       }
     }
-    mShow.Play();
+    mClock.Play( mShow );
     mShow.FinishedSignal().Connect( this, &PerfScroll::OnAnimationEnd );
   }
 
@@ -387,10 +491,11 @@ public:
     Stage stage = Stage::GetCurrent();
     Vector3 stageSize( stage.GetSize() );
 
+    mFrameTimingRecorder.SetPhase( "scroll" );
     mScroll = Animation::New( gDuration );
 
     mScroll.AnimateBy( Property( mParent, Actor::Property::POSITION ), Vector3( -(gPageCount-1.)*stageSize.x,0.0f, 0.0f) );
-    mScroll.Play();
+    mClock.Play( mScroll );
     mScroll.FinishedSignal().Connect( this, &PerfScroll::OnAnimationEnd );
   }
 
@@ -398,6 +503,7 @@ public:
   {
     size_t count(0);
     unsigned int actorsPerPage( mRowsPerPage*mColumnsPerPage );
+    mFrameTimingRecorder.SetPhase( "hide" );
     mHide = Animation::New( 0.0f );
 
     unsigned int totalColumns = mColumnsPerPage * mPageCount;
@@ -431,7 +537,7 @@ public:
       }
     }
 
-    mHide.Play();
+    mClock.Play( mHide );
     mHide.FinishedSignal().Connect( this, &PerfScroll::OnAnimationEnd );
   }
 
@@ -446,10 +552,15 @@ private:
   unsigned int        mRowsPerPage;
   unsigned int        mColumnsPerPage;
   unsigned int        mPageCount;
+  unsigned int        mPendingTextures;  ///< Textures still being loaded in the background
+  bool                mActorsCreated;
 
   Animation           mShow;
   Animation           mScroll;
   Animation           mHide;
+
+  DemoHelper::FrameTimingRecorder mFrameTimingRecorder;
+  DemoHelper::FixedStepClock      mClock;
 };
 
 void RunTest( Application& application )
@@ -457,17 +568,25 @@ void RunTest( Application& application )
   PerfScroll test( application );
 
   application.MainLoop();
+
+  test.WriteReport();
 }
 
 // Entry point for Linux & Tizen applications
 //
 int DALI_EXPORT_API main( int argc, char **argv )
 {
-  Application application = Application::New( &argc, &argv );
+  // Arguments passed on to each run of a sweep or regression check
+  std::vector<std::string> runArguments;
 
   for( int i(1) ; i < argc; ++i )
   {
     std::string arg( argv[i] );
+    if( !DemoHelper::IsBenchmarkDriverArgument( arg ) )
+    {
+      runArguments.push_back( arg );
+    }
+
     if( arg.compare("--use-mesh") == 0)
     {
       gUseMesh = true;
@@ -476,12 +595,87 @@ int DALI_EXPORT_API main( int argc, char **argv )
     {
       gNinePatch = true;
     }
+    else if( arg.compare(0, 2, "-r" ) == 0)
+    {
+      gRowsPerPage = atoi( arg.substr( 2, arg.size()).c_str());
+    }
+    else if( arg.compare(0, 2, "-c" ) == 0)
+    {
+      gColumnsPerPage = atoi( arg.substr( 2, arg.size()).c_str());
+    }
+    else if( arg.compare(0, 2, "-p" ) == 0)
+    {
+      gPageCount = atoi( arg.substr( 2, arg.size()).c_str());
+    }
     else if( arg.compare(0, 2, "-t" ) == 0)
     {
       gDuration = atof( arg.substr( 2, arg.size()).c_str());
     }
+    else if( arg.compare("--headless" ) == 0)
+    {
+      gHeadless = true;
+    }
+    else if( arg.compare(0, 13, "--frame-step=" ) == 0)
+    {
+      gFrameStep = atoi( arg.substr( 13 ).c_str());
+    }
+    else if( arg.compare(0, 9, "--report=" ) == 0)
+    {
+      gReportPath = arg.substr( 9 );
+    }
+    else if( arg.compare(0, 8, "--sweep=" ) == 0)
+    {
+      gSweep = arg.substr( 8 );
+    }
+    else if( arg.compare("--sweep" ) == 0 && i + 1 < argc )
+    {
+      gSweep = argv[++i];
+    }
+    else if( arg.compare(0, 14, "--frame-times=" ) == 0)
+    {
+      gFrameTimesPath = arg.substr( 14 );
+    }
+    else if( arg.compare(0, 11, "--baseline=" ) == 0)
+    {
+      gBaselinePath = arg.substr( 11 );
+    }
+    else if( arg.compare(0, 16, "--save-baseline=" ) == 0)
+    {
+      gSaveBaselinePath = arg.substr( 16 );
+    }
+    else if( arg.compare(0, 7, "--runs=" ) == 0)
+    {
+      gRegressionOptions.mRuns = atoi( arg.substr( 7 ).c_str());
+    }
+    else if( arg.compare(0, 17, "--max-regression=" ) == 0)
+    {
+      gRegressionOptions.mMaxRegression = atof( arg.substr( 17 ).c_str());
+    }
+  }
+
+  if( !gSweep.empty() )
+  {
+    std::vector<DemoHelper::SweepDimension> dimensions;
+    if( !DemoHelper::ParseSweep( gSweep, SWEEP_OPTIONS, NUM_SWEEP_OPTIONS, dimensions ) )
+    {
+      return EXIT_FAILURE;
+    }
+    return DemoHelper::RunSweep( argv[0], runArguments, dimensions, gReportPath );
   }
 
+  if( !gSaveBaselinePath.empty() )
+  {
+    return DemoHelper::RecordBaseline( argv[0], runArguments, gSaveBaselinePath, gRegressionOptions );
+  }
+
+  if( !gBaselinePath.empty() )
+  {
+    return DemoHelper::CheckRegression( argv[0], runArguments, gBaselinePath, gRegressionOptions );
+  }
+
+  Application application = Application::New( &argc, &argv );
+  DemoHelper::ReportLaunchTiming( application );
+
   RunTest( application );
 
   return 0;
@@ -23,6 +23,7 @@
 #include "renderer-stencil-shaders.h"
 #include "shared/view.h"
 #include "shared/utility.h"
+#include "shared/launch-timing.h"
 
 using namespace Dali;
 
@@ -775,6 +776,7 @@ void RunExample( Application& application )
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv );
+  DemoHelper::ReportLaunchTiming( application );
 
   RunExample( application );
 
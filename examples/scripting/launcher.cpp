@@ -19,11 +19,11 @@
 #include "launcher.h"
 
 // EXTERNAL INCLUDES
-#include <fstream>
 #include <sys/stat.h>
 #include <dali/integration-api/debug.h>
 
 // INTERNAL INCLUDES
+#include "shared/compiled-layout.h"
 #include "shared/view.h"
 
 
@@ -32,17 +32,6 @@ using namespace Dali::Toolkit;
 
 #define TOKEN_STRING(x) #x
 
-namespace
-{
-std::string GetFileContents(const std::string& filename)
-{
-  std::ifstream t(filename.c_str());
-  return std::string((std::istreambuf_iterator<char>(t)),
-                     std::istreambuf_iterator<char>());
-};
-
-} // unnamed namespace
-
 Launcher::Launcher( Dali::Application application, std::string layoutFileName, std::string scriptFileName )
 : mApplication( application ),
   mJSONFileName(layoutFileName ),
@@ -84,7 +73,8 @@ void Launcher::Create( Dali::Application& application )
     defaultDirs[ TOKEN_STRING(DEMO_SCRIPT_DIR) ] = DEMO_SCRIPT_DIR;
     mBuilder.AddConstants( defaultDirs );
 
-    std::string json_data(GetFileContents( mJSONFileName ));
+    // The compiled layout, if it is installed and up to date
+    std::string json_data(DemoHelper::ReadLayout( mJSONFileName ));
     mBuilder.LoadFromString(json_data);
     mBuilder.AddActors( stage.GetRootLayer() );
   }
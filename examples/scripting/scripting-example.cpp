@@ -23,6 +23,7 @@
 
 // INTERNAL INCLUDES
 #include "launcher.h"
+#include "shared/launch-timing.h"
 
 namespace
 {
@@ -86,7 +87,10 @@ int DALI_EXPORT_API main( int argc, char* argv[] )
   }
 
 
-  Launcher daliApplication( Dali::Application::New( &argc, &argv, DEMO_THEME_PATH ), jSONFileName, javaScriptFileName );
+  Dali::Application application = Dali::Application::New( &argc, &argv, DEMO_THEME_PATH );
+  DemoHelper::ReportLaunchTiming( application );
+
+  Launcher daliApplication( application, jSONFileName, javaScriptFileName );
 
   daliApplication.MainLoop();
 
@@ -23,6 +23,7 @@
 #include <map>
 
 #include "shared/utility.h"
+#include "shared/launch-timing.h"
 #include "sparkle-effect.h"
 
 using namespace Dali;
@@ -560,6 +561,7 @@ void RunTest( Application& application )
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv );
+  DemoHelper::ReportLaunchTiming( application );
 
   RunTest( application );
 
@@ -24,6 +24,7 @@
 
 // Internal includes
 #include "styling-application.h"
+#include "shared/launch-timing.h"
 
 
 /// Entry point for applications
@@ -45,6 +46,7 @@ int DALI_EXPORT_API main( int argc, char** argv )
   }
 
   Application application = Application::New( &argc, &argv, themeName );
+  DemoHelper::ReportLaunchTiming( application );
   {
     Demo::StylingApplication stylingApplication( application );
     application.MainLoop();
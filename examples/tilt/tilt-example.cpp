@@ -17,6 +17,7 @@
 
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali/devel-api/adaptor-framework/tilt-sensor.h>
+#include "shared/launch-timing.h"
 
 using namespace Dali;
 using Dali::Toolkit::TextLabel;
@@ -117,6 +118,7 @@ private:
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv );
+  DemoHelper::ReportLaunchTiming( application );
   TiltController test( application );
 
   application.MainLoop();
@@ -142,6 +142,7 @@ exit 0
 %{dali_app_res_dir}/scripts/*
 %{dali_app_res_dir}/style/*
 %{dali_app_res_dir}/style/images/*
+%{dali_app_res_dir}/catalogues/*
 %{dali_xml_file_dir}/%{name}.xml
 %{dali_icon_dir}/*
 %{locale_dir}/*
@@ -0,0 +1,313 @@
+#ifndef DALI_DEMO_ASYNC_TEXTURE_LOADER_H
+#define DALI_DEMO_ASYNC_TEXTURE_LOADER_H
+
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <dali/dali.h>
+#include <dali/devel-api/adaptor-framework/bitmap-loader.h>
+#include <dali/devel-api/adaptor-framework/event-thread-callback.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+// INTERNAL INCLUDES
+#include "shared/utility.h"
+
+namespace DemoHelper
+{
+
+/**
+ * @brief Decodes images on a pool of worker threads and uploads them on the event thread.
+ *
+ * There is a worker per core, started on the first load. Workers only decode; the textures
+ * are created and uploaded on the event thread, then added to the TextureCache so later
+ * synchronous LoadTexture() calls share them. Loads of the same image that are in flight
+ * together are decoded once.
+ *
+ * Must only be called from the event thread.
+ */
+class AsyncTextureLoader
+{
+public:
+
+  /**
+   * @brief Returns the loader. It is never destroyed, as its workers may still be decoding at exit.
+   */
+  static AsyncTextureLoader& Get()
+  {
+    static AsyncTextureLoader* loader = new AsyncTextureLoader;
+    return *loader;
+  }
+
+  /**
+   * @brief Loads an image in the background and sets it as texture @p index of @p textureSet once uploaded.
+   *
+   * If the texture is already cached it is set straight away.
+   *
+   * @param[in] finishedCallback Optional callback executed on the event thread once the texture is set.
+   *                             Ownership is taken.
+   */
+  void Load( const char* imagePath,
+             Dali::TextureSet textureSet,
+             unsigned int index,
+             Dali::CallbackBase* finishedCallback = NULL,
+             Dali::ImageDimensions size = Dali::ImageDimensions(),
+             Dali::FittingMode::Type fittingMode = Dali::FittingMode::DEFAULT,
+             Dali::SamplingMode::Type samplingMode = Dali::SamplingMode::DEFAULT )
+  {
+    Dali::Texture texture = TextureCache::Get().Find( imagePath, size, fittingMode, samplingMode );
+    if( texture )
+    {
+      textureSet.SetTexture( index, texture );
+      if( finishedCallback )
+      {
+        Dali::CallbackBase::Execute( *finishedCallback );
+        delete finishedCallback;
+      }
+      return;
+    }
+
+    Target target( textureSet, index, finishedCallback );
+
+    // Join a load of the same image that is still in flight
+    for( std::vector<Job*>::iterator iter = mPendingJobs.begin(); iter != mPendingJobs.end(); ++iter )
+    {
+      Job& job = **iter;
+      if( job.mPath == imagePath && job.mSize == size && job.mFittingMode == fittingMode && job.mSamplingMode == samplingMode )
+      {
+        job.mTargets.push_back( target );
+        return;
+      }
+    }
+
+    StartWorkers();
+
+    // The loader handle is created here and only used, never copied, by the worker.
+    Job* job = new Job( imagePath, size, fittingMode, samplingMode );
+    job->mLoader = Dali::BitmapLoader::New( imagePath, size, fittingMode, samplingMode );
+    job->mTargets.push_back( target );
+    mPendingJobs.push_back( job );
+
+    pthread_mutex_lock( &mMutex );
+    mQueue.push_back( job );
+    pthread_cond_signal( &mCondition );
+    pthread_mutex_unlock( &mMutex );
+  }
+
+  /**
+   * @brief The number of loads that have not been uploaded yet.
+   */
+  unsigned int GetPendingCount() const
+  {
+    return mPendingJobs.size();
+  }
+
+private:
+
+  /**
+   * @brief Where a loaded texture goes.
+   */
+  struct Target
+  {
+    Target( Dali::TextureSet textureSet, unsigned int index, Dali::CallbackBase* finishedCallback )
+    : mTextureSet( textureSet ),
+      mIndex( index ),
+      mFinishedCallback( finishedCallback )
+    {
+    }
+
+    Dali::TextureSet    mTextureSet;
+    unsigned int        mIndex;
+    Dali::CallbackBase* mFinishedCallback;
+  };
+
+  struct Job
+  {
+    Job( const char* imagePath, Dali::ImageDimensions size, Dali::FittingMode::Type fittingMode, Dali::SamplingMode::Type samplingMode )
+    : mPath( imagePath ),
+      mSize( size ),
+      mFittingMode( fittingMode ),
+      mSamplingMode( samplingMode )
+    {
+    }
+
+    std::string              mPath;
+    Dali::ImageDimensions    mSize;
+    Dali::FittingMode::Type  mFittingMode;
+    Dali::SamplingMode::Type mSamplingMode;
+    Dali::BitmapLoader       mLoader;
+    std::vector<Target>      mTargets;
+  };
+
+  AsyncTextureLoader()
+  : mEventTrigger( NULL )
+  {
+    pthread_mutex_init( &mMutex, NULL );
+    pthread_cond_init( &mCondition, NULL );
+  }
+
+  /**
+   * @brief Starts a worker per core, the first time only.
+   */
+  void StartWorkers()
+  {
+    if( mEventTrigger )
+    {
+      return;
+    }
+
+    mEventTrigger = new Dali::EventThreadCallback( Dali::MakeCallback( this, &AsyncTextureLoader::OnJobsDecoded ) );
+
+    long cores = sysconf( _SC_NPROCESSORS_ONLN );
+    cores = cores > 0 ? cores : 1;
+    for( long i = 0; i < cores; ++i )
+    {
+      pthread_t thread;
+      if( pthread_create( &thread, NULL, &AsyncTextureLoader::Worker, this ) == 0 )
+      {
+        pthread_detach( thread );
+      }
+    }
+  }
+
+  /**
+   * @brief Decodes queued jobs and hands them back to the event thread.
+   */
+  static void* Worker( void* data )
+  {
+    AsyncTextureLoader& loader = *static_cast<AsyncTextureLoader*>( data );
+    for( ;; )
+    {
+      pthread_mutex_lock( &loader.mMutex );
+      while( loader.mQueue.empty() )
+      {
+        pthread_cond_wait( &loader.mCondition, &loader.mMutex );
+      }
+      Job* job = loader.mQueue.front();
+      loader.mQueue.pop_front();
+      pthread_mutex_unlock( &loader.mMutex );
+
+      job->mLoader.Load();
+
+      pthread_mutex_lock( &loader.mMutex );
+      loader.mDecoded.push_back( job );
+      pthread_mutex_unlock( &loader.mMutex );
+
+      loader.mEventTrigger->Trigger();
+    }
+    return NULL;
+  }
+
+  /**
+   * @brief Uploads the decoded images and sets them as textures. Called on the event thread.
+   *
+   * Triggers may be coalesced, so everything decoded so far is processed.
+   */
+  void OnJobsDecoded()
+  {
+    std::deque<Job*> decoded;
+    pthread_mutex_lock( &mMutex );
+    decoded.swap( mDecoded );
+    pthread_mutex_unlock( &mMutex );
+
+    for( std::deque<Job*>::iterator iter = decoded.begin(); iter != decoded.end(); ++iter )
+    {
+      Job* job = *iter;
+      Dali::Texture texture = UploadTexture( *job );
+
+      for( std::vector<Target>::iterator target = job->mTargets.begin(); target != job->mTargets.end(); ++target )
+      {
+        if( texture )
+        {
+          target->mTextureSet.SetTexture( target->mIndex, texture );
+        }
+        if( target->mFinishedCallback )
+        {
+          Dali::CallbackBase::Execute( *target->mFinishedCallback );
+          delete target->mFinishedCallback;
+        }
+      }
+
+      mPendingJobs.erase( std::find( mPendingJobs.begin(), mPendingJobs.end(), job ) );
+      delete job;
+    }
+  }
+
+  /**
+   * @brief Creates and caches the texture of a decoded job, or returns an empty handle if decoding failed.
+   */
+  static Dali::Texture UploadTexture( Job& job )
+  {
+    Dali::PixelData pixelData = job.mLoader.GetPixelData();
+    if( !pixelData )
+    {
+      return Dali::Texture();
+    }
+
+    Dali::Texture texture = Dali::Texture::New( Dali::TextureType::TEXTURE_2D,
+                                                pixelData.GetPixelFormat(),
+                                                pixelData.GetWidth(),
+                                                pixelData.GetHeight() );
+    texture.Upload( pixelData );
+
+    // Compressed formats report no bytes per pixel; count them as one.
+    const unsigned int bytesPerPixel = std::max( Dali::Pixel::GetBytesPerPixel( pixelData.GetPixelFormat() ), 1u );
+    TextureCache::Get().Add( job.mPath.c_str(), job.mSize, job.mFittingMode, job.mSamplingMode, texture,
+                             pixelData.GetWidth() * pixelData.GetHeight() * bytesPerPixel );
+    return texture;
+  }
+
+  // Undefined
+  AsyncTextureLoader( const AsyncTextureLoader& );
+  AsyncTextureLoader& operator=( const AsyncTextureLoader& );
+
+private:
+
+  std::vector<Job*>          mPendingJobs;  ///< Jobs queued or decoding, only used on the event thread
+
+  pthread_mutex_t            mMutex;        ///< Guards mQueue and mDecoded
+  pthread_cond_t             mCondition;    ///< Signalled when a job is queued
+  std::deque<Job*>           mQueue;        ///< Jobs waiting for a worker
+  std::deque<Job*>           mDecoded;      ///< Jobs waiting for the event thread
+
+  Dali::EventThreadCallback* mEventTrigger; ///< Wakes the event thread when jobs are decoded
+};
+
+/**
+ * @brief Loads an image on a worker thread and sets it as texture @p index of @p textureSet once uploaded.
+ *
+ * @see AsyncTextureLoader::Load
+ */
+void LoadTextureAsync( const char* imagePath,
+                       Dali::TextureSet textureSet,
+                       unsigned int index,
+                       Dali::CallbackBase* finishedCallback = NULL,
+                       Dali::ImageDimensions size = Dali::ImageDimensions(),
+                       Dali::FittingMode::Type fittingMode = Dali::FittingMode::DEFAULT,
+                       Dali::SamplingMode::Type samplingMode = Dali::SamplingMode::DEFAULT )
+{
+  AsyncTextureLoader::Get().Load( imagePath, textureSet, index, finishedCallback, size, fittingMode, samplingMode );
+}
+
+} // DemoHelper
+
+#endif // DALI_DEMO_ASYNC_TEXTURE_LOADER_H
@@ -0,0 +1,293 @@
+#ifndef DALI_DEMO_BENCHMARK_COMPARE_H
+#define DALI_DEMO_BENCHMARK_COMPARE_H
+
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+// INTERNAL INCLUDES
+#include "shared/benchmark-sweep.h"
+
+/**
+ * Regression checks for the benchmark executables.
+ *
+ * A baseline is the pooled frame times ("phase,frame_ms" CSV, as written by
+ * FrameTimingRecorder::WriteFrameTimes()) of several runs of a scenario. A check
+ * re-runs the same scenario the same number of times in fresh processes and, for
+ * every phase, tests whether the new frame times are significantly slower with a
+ * one-sided Mann-Whitney U test. A phase regresses when the test is significant
+ * and its p95 frame time grew by more than the allowed percentage.
+ */
+namespace DemoHelper
+{
+
+typedef std::map< std::string, std::vector<double> > FrameTimes; ///< Frame durations in milliseconds, by phase
+
+/**
+ * @brief Settings of a regression check.
+ */
+struct RegressionOptions
+{
+  RegressionOptions()
+  : mRuns( 5u ),
+    mMaxRegression( 5.0 ),
+    mSignificance( 0.01 )
+  {
+  }
+
+  unsigned int mRuns;          ///< Number of runs pooled together
+  double       mMaxRegression; ///< Allowed growth of the p95 frame time, in percent
+  double       mSignificance;  ///< Largest p-value considered significant
+};
+
+/**
+ * @brief Whether @p argument controls the benchmark driver itself (sweeps, baselines, reports)
+ * rather than the scenario, so must not be passed on to the runs it starts.
+ */
+bool IsBenchmarkDriverArgument( const std::string& argument )
+{
+  static const char* DRIVER_ARGUMENTS[] = { "--sweep", "--report=", "--frame-times=", "--baseline=", "--save-baseline=", "--runs=", "--max-regression=" };
+  for( unsigned int i = 0; i < sizeof( DRIVER_ARGUMENTS ) / sizeof( DRIVER_ARGUMENTS[0] ); ++i )
+  {
+    if( argument.compare( 0, strlen( DRIVER_ARGUMENTS[i] ), DRIVER_ARGUMENTS[i] ) == 0 )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Appends the frame times in the "phase,frame_ms" CSV file at @p path to @p frameTimes.
+ * @return true if the file could be read
+ */
+bool ReadFrameTimes( const std::string& path, FrameTimes& frameTimes )
+{
+  std::ifstream file( path.c_str() );
+  if( !file )
+  {
+    std::cerr << "Unable to read frame times from " << path << std::endl;
+    return false;
+  }
+
+  std::string line;
+  std::getline( file, line ); // header
+  while( std::getline( file, line ) )
+  {
+    size_t comma = line.find( ',' );
+    if( comma != std::string::npos )
+    {
+      frameTimes[ line.substr( 0, comma ) ].push_back( atof( line.substr( comma + 1 ).c_str() ) );
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Writes @p frameTimes to @p path as "phase,frame_ms" CSV.
+ */
+bool WriteFrameTimes( const std::string& path, const FrameTimes& frameTimes )
+{
+  std::ofstream file( path.c_str() );
+  file << "phase,frame_ms\n";
+  for( FrameTimes::const_iterator iter = frameTimes.begin(); iter != frameTimes.end(); ++iter )
+  {
+    for( size_t i = 0; i < iter->second.size(); ++i )
+    {
+      file << iter->first << "," << iter->second[i] << "\n";
+    }
+  }
+  file.flush();
+  if( !file.good() )
+  {
+    std::cerr << "Unable to write frame times to " << path << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Runs the scenario @p runs times, each in a fresh process, and pools the frame times.
+ */
+bool CollectFrameTimes( const std::string& executable, const std::vector<std::string>& arguments, unsigned int runs, FrameTimes& frameTimes )
+{
+  for( unsigned int run = 0; run < runs; ++run )
+  {
+    std::string path = CreateTemporaryFile( ".csv" );
+    if( path.empty() )
+    {
+      return false;
+    }
+
+    std::vector<std::string> runArguments( arguments );
+    runArguments.push_back( "--report=/dev/null" );
+    runArguments.push_back( "--frame-times=" + path );
+
+    std::cerr << "Run " << ( run + 1 ) << "/" << runs << std::endl;
+    long maxRss = 0;
+    bool succeeded = RunBenchmarkProcess( executable, runArguments, maxRss ) && ReadFrameTimes( path, frameTimes );
+    unlink( path.c_str() );
+    if( !succeeded )
+    {
+      std::cerr << "Benchmark run failed: " << executable << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Nearest-rank 95th percentile of a non-empty list.
+ */
+double Percentile95( std::vector<double> values )
+{
+  std::sort( values.begin(), values.end() );
+  size_t rank = static_cast<size_t>( std::ceil( 0.95 * values.size() ) );
+  return values[ std::max( rank, size_t( 1u ) ) - 1u ];
+}
+
+/**
+ * @brief One-sided Mann-Whitney U test of whether @p current tends to be larger than @p baseline.
+ *
+ * Uses the normal approximation with tie and continuity corrections, which is accurate for
+ * the hundreds of frames a benchmark run produces.
+ * @return The p-value
+ */
+double MannWhitneyGreater( const std::vector<double>& current, const std::vector<double>& baseline )
+{
+  const double n1 = current.size();
+  const double n2 = baseline.size();
+  const double n = n1 + n2;
+
+  // Pairs of value and whether it is from the current run; ranked together.
+  std::vector< std::pair<double, bool> > values;
+  values.reserve( current.size() + baseline.size() );
+  for( size_t i = 0; i < current.size(); ++i )
+  {
+    values.push_back( std::make_pair( current[i], true ) );
+  }
+  for( size_t i = 0; i < baseline.size(); ++i )
+  {
+    values.push_back( std::make_pair( baseline[i], false ) );
+  }
+  std::sort( values.begin(), values.end() );
+
+  double rankSum = 0.0;
+  double tieCorrection = 0.0;
+  for( size_t i = 0; i < values.size(); )
+  {
+    size_t j = i;
+    while( j < values.size() && values[j].first == values[i].first )
+    {
+      ++j;
+    }
+
+    const double averageRank = ( i + 1 + j ) * 0.5; // ranks i+1 .. j
+    const double ties = j - i;
+    tieCorrection += ties * ties * ties - ties;
+    for( size_t k = i; k < j; ++k )
+    {
+      if( values[k].second )
+      {
+        rankSum += averageRank;
+      }
+    }
+    i = j;
+  }
+
+  const double u = rankSum - n1 * ( n1 + 1.0 ) * 0.5;
+  const double mean = n1 * n2 * 0.5;
+  const double variance = n1 * n2 / 12.0 * ( ( n + 1.0 ) - tieCorrection / ( n * ( n - 1.0 ) ) );
+  if( variance <= 0.0 )
+  {
+    return 1.0;
+  }
+
+  const double z = ( u - mean - 0.5 ) / std::sqrt( variance );
+  return 0.5 * erfc( z / std::sqrt( 2.0 ) );
+}
+
+/**
+ * @brief Runs the scenario and records the pooled frame times as the baseline at @p baselinePath.
+ * @return The process exit code
+ */
+int RecordBaseline( const std::string& executable, const std::vector<std::string>& arguments, const std::string& baselinePath, const RegressionOptions& options )
+{
+  FrameTimes frameTimes;
+  if( !CollectFrameTimes( executable, arguments, options.mRuns, frameTimes ) ||
+      !WriteFrameTimes( baselinePath, frameTimes ) )
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Runs the scenario and compares it against the baseline at @p baselinePath.
+ *
+ * Prints a line per phase and returns a failure exit code if any phase regressed.
+ * @return The process exit code
+ */
+int CheckRegression( const std::string& executable, const std::vector<std::string>& arguments, const std::string& baselinePath, const RegressionOptions& options )
+{
+  FrameTimes baseline;
+  FrameTimes current;
+  if( !ReadFrameTimes( baselinePath, baseline ) ||
+      !CollectFrameTimes( executable, arguments, options.mRuns, current ) )
+  {
+    return EXIT_FAILURE;
+  }
+
+  bool regressed = false;
+  std::cout << "phase,baseline_p95_ms,current_p95_ms,change_percent,p_value,result\n";
+  for( FrameTimes::const_iterator iter = baseline.begin(); iter != baseline.end(); ++iter )
+  {
+    FrameTimes::const_iterator currentIter = current.find( iter->first );
+    if( iter->second.empty() || currentIter == current.end() || currentIter->second.empty() )
+    {
+      std::cout << iter->first << ",,,,,missing\n";
+      regressed = true;
+      continue;
+    }
+
+    const double baselineP95 = Percentile95( iter->second );
+    const double currentP95 = Percentile95( currentIter->second );
+    const double change = baselineP95 > 0.0 ? ( currentP95 - baselineP95 ) * 100.0 / baselineP95 : 0.0;
+    const double pValue = MannWhitneyGreater( currentIter->second, iter->second );
+    const bool phaseRegressed = pValue < options.mSignificance && change > options.mMaxRegression;
+    regressed = regressed || phaseRegressed;
+
+    std::cout << iter->first << ","
+              << baselineP95 << ","
+              << currentP95 << ","
+              << change << ","
+              << pValue << ","
+              << ( phaseRegressed ? "REGRESSED" : "ok" ) << "\n";
+  }
+  std::cout.flush();
+
+  return regressed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+} // DemoHelper
+
+#endif // DALI_DEMO_BENCHMARK_COMPARE_H
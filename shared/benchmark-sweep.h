@@ -0,0 +1,396 @@
+#ifndef DALI_DEMO_BENCHMARK_SWEEP_H
+#define DALI_DEMO_BENCHMARK_SWEEP_H
+
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * Parameter sweeps for the benchmark executables.
+ *
+ * A sweep such as "rows=5..50:5,pages=1..20" runs the benchmark once for every
+ * combination of the given values, each time in a fresh process so that no state
+ * (caches, allocator high-water marks, GL resources) leaks between runs. Each run
+ * writes its frame timing report to a temporary CSV file, and the peak RSS of the
+ * child is taken from wait4(). The results are collected into one scaling table.
+ */
+namespace DemoHelper
+{
+
+/**
+ * @brief Maps a sweep parameter name to the command line flag of the benchmark.
+ */
+struct SweepOption
+{
+  const char* mName; ///< The name used in the sweep specification, e.g. "rows"
+  const char* mFlag; ///< The flag the value is appended to, e.g. "-r"
+};
+
+/**
+ * @brief One swept parameter, covering [mFrom, mTo] in increments of mStep.
+ */
+struct SweepDimension
+{
+  std::string mName;
+  std::string mFlag;
+  int         mFrom;
+  int         mTo;
+  int         mStep;
+};
+
+/**
+ * @brief The outcome of a single run of the sweep.
+ */
+struct SweepResult
+{
+  std::vector<int>                                   mValues;     ///< The value of each dimension
+  std::vector< std::pair<std::string, std::string> > mParameters; ///< Parameters reported by the run
+  std::vector< std::vector<std::string> >            mPhases;     ///< The CSV rows of the frame timing report
+  long                                               mMaxRss;     ///< Peak resident set size in KB
+  bool                                               mSucceeded;
+};
+
+/**
+ * @brief Parses a sweep specification of the form "name=from..to[:step],name=value,...".
+ * @param[in] specification The sweep specification
+ * @param[in] options The parameters that may be swept
+ * @param[in] optionCount The number of entries in @p options
+ * @param[out] dimensions The parsed dimensions
+ * @return true if the specification is valid
+ */
+bool ParseSweep( const std::string& specification, const SweepOption* options, unsigned int optionCount, std::vector<SweepDimension>& dimensions )
+{
+  std::stringstream stream( specification );
+  std::string item;
+  while( std::getline( stream, item, ',' ) )
+  {
+    size_t equals = item.find( '=' );
+    if( equals == std::string::npos )
+    {
+      std::cerr << "Invalid sweep parameter: " << item << std::endl;
+      return false;
+    }
+
+    SweepDimension dimension;
+    dimension.mName = item.substr( 0, equals );
+    for( unsigned int i = 0; i < optionCount; ++i )
+    {
+      if( dimension.mName == options[i].mName )
+      {
+        dimension.mFlag = options[i].mFlag;
+      }
+    }
+    if( dimension.mFlag.empty() )
+    {
+      std::cerr << "Unknown sweep parameter: " << dimension.mName << std::endl;
+      return false;
+    }
+
+    std::string range = item.substr( equals + 1 );
+    dimension.mStep = 1;
+    size_t colon = range.find( ':' );
+    if( colon != std::string::npos )
+    {
+      dimension.mStep = atoi( range.substr( colon + 1 ).c_str() );
+      range = range.substr( 0, colon );
+    }
+    size_t dots = range.find( ".." );
+    dimension.mFrom = atoi( range.substr( 0, dots ).c_str() );
+    dimension.mTo = dots != std::string::npos ? atoi( range.substr( dots + 2 ).c_str() ) : dimension.mFrom;
+
+    if( dimension.mStep <= 0 || dimension.mTo < dimension.mFrom )
+    {
+      std::cerr << "Invalid sweep range: " << item << std::endl;
+      return false;
+    }
+    dimensions.push_back( dimension );
+  }
+
+  return !dimensions.empty();
+}
+
+/**
+ * @brief Creates an empty temporary file with the given suffix.
+ * @param[in] suffix The file name suffix, e.g. ".csv"
+ * @return The path of the file, or an empty string on failure
+ */
+std::string CreateTemporaryFile( const std::string& suffix )
+{
+  std::string pattern = "/tmp/dali-benchmark-XXXXXX" + suffix;
+  std::vector<char> path( pattern.begin(), pattern.end() );
+  path.push_back( '\0' );
+
+  int fd = mkstemps( &path[0], suffix.size() );
+  if( fd < 0 )
+  {
+    std::cerr << "Unable to create a temporary file" << std::endl;
+    return std::string();
+  }
+  close( fd );
+  return std::string( &path[0] );
+}
+
+/**
+ * @brief Runs @p executable with @p arguments in a child process and waits for it to finish.
+ * @param[in] executable The executable, looked up in PATH if it has no directory
+ * @param[in] arguments The arguments, not including the executable name
+ * @param[out] maxRss The peak resident set size of the child in KB
+ * @return true if the child exited with status 0
+ */
+bool RunBenchmarkProcess( const std::string& executable, const std::vector<std::string>& arguments, long& maxRss )
+{
+  std::vector<std::string> childArguments( arguments );
+  childArguments.insert( childArguments.begin(), executable );
+
+  std::vector<char*> argv;
+  for( size_t i = 0; i < childArguments.size(); ++i )
+  {
+    argv.push_back( const_cast<char*>( childArguments[i].c_str() ) );
+  }
+  argv.push_back( NULL );
+
+  pid_t pid = fork();
+  if( pid == 0 )
+  {
+    execvp( argv[0], &argv[0] );
+    _exit( 127 );
+  }
+  else if( pid < 0 )
+  {
+    std::cerr << "Unable to fork: " << executable << std::endl;
+    return false;
+  }
+
+  int status = 0;
+  struct rusage usage;
+  if( wait4( pid, &status, 0, &usage ) != pid )
+  {
+    return false;
+  }
+  maxRss = usage.ru_maxrss;
+  return WIFEXITED( status ) && WEXITSTATUS( status ) == 0;
+}
+
+/**
+ * @brief Runs @p executable once with @p arguments and reads back its CSV frame timing report.
+ */
+bool RunSweepConfiguration( const std::string& executable, const std::vector<std::string>& arguments, SweepResult& result )
+{
+  std::string reportPath = CreateTemporaryFile( ".csv" );
+  if( reportPath.empty() )
+  {
+    return false;
+  }
+
+  std::vector<std::string> runArguments( arguments );
+  runArguments.push_back( "--report=" + reportPath );
+  result.mSucceeded = RunBenchmarkProcess( executable, runArguments, result.mMaxRss );
+
+  std::ifstream report( reportPath.c_str() );
+  std::string line;
+  bool header = true;
+  while( std::getline( report, line ) )
+  {
+    if( line.compare( 0, 2, "# " ) == 0 )
+    {
+      size_t equals = line.find( '=' );
+      if( equals != std::string::npos )
+      {
+        result.mParameters.push_back( std::make_pair( line.substr( 2, equals - 2 ), line.substr( equals + 1 ) ) );
+      }
+    }
+    else if( header )
+    {
+      header = false;
+    }
+    else if( !line.empty() )
+    {
+      std::vector<std::string> columns;
+      std::stringstream row( line );
+      std::string column;
+      while( std::getline( row, column, ',' ) )
+      {
+        columns.push_back( column );
+      }
+      result.mPhases.push_back( columns );
+    }
+  }
+  unlink( reportPath.c_str() );
+
+  return result.mSucceeded && !result.mPhases.empty();
+}
+
+/**
+ * @brief Writes the scaling table: one line per configuration, with each phase's mean, p95 and max
+ * frame time, the mean frame time per actor, the peak RSS of the run and the memory cost per actor.
+ */
+void WriteSweepTable( std::ostream& stream, const std::vector<SweepDimension>& dimensions, const std::vector<SweepResult>& results )
+{
+  // Phase rows are: phase,frames,mean_ms,p50_ms,p95_ms,p99_ms,max_ms,dropped
+  const std::vector< std::vector<std::string> >* phases = NULL;
+  for( size_t i = 0; i < results.size() && !phases; ++i )
+  {
+    if( !results[i].mPhases.empty() )
+    {
+      phases = &results[i].mPhases;
+    }
+  }
+
+  for( size_t i = 0; i < dimensions.size(); ++i )
+  {
+    stream << dimensions[i].mName << ",";
+  }
+  stream << "actors,max_rss_kb,bytes_per_actor";
+  for( size_t i = 0; phases && i < phases->size(); ++i )
+  {
+    const std::string& name = (*phases)[i][0];
+    stream << "," << name << "_mean_ms," << name << "_p95_ms," << name << "_max_ms," << name << "_dropped," << name << "_us_per_actor";
+  }
+  stream << "\n";
+
+  for( size_t i = 0; i < results.size(); ++i )
+  {
+    const SweepResult& result = results[i];
+    for( size_t j = 0; j < result.mValues.size(); ++j )
+    {
+      stream << result.mValues[j] << ",";
+    }
+
+    double actors = 0.0;
+    double bytesPerActor = 0.0;
+    for( size_t j = 0; j < result.mParameters.size(); ++j )
+    {
+      if( result.mParameters[j].first == "actors" )
+      {
+        actors = atof( result.mParameters[j].second.c_str() );
+      }
+      else if( result.mParameters[j].first == "bytes_per_actor" )
+      {
+        bytesPerActor = atof( result.mParameters[j].second.c_str() );
+      }
+    }
+    stream << actors << "," << result.mMaxRss << "," << bytesPerActor;
+
+    for( size_t j = 0; phases && j < phases->size(); ++j )
+    {
+      if( j < result.mPhases.size() && result.mPhases[j].size() >= 8u )
+      {
+        const std::vector<std::string>& phase = result.mPhases[j];
+        const double mean = atof( phase[2].c_str() );
+        stream << "," << phase[2] << "," << phase[4] << "," << phase[6] << "," << phase[7] << ",";
+        stream << ( actors > 0.0 ? mean * 1000.0 / actors : 0.0 );
+      }
+      else
+      {
+        stream << ",,,,,";
+      }
+    }
+    stream << "\n";
+  }
+  stream.flush();
+}
+
+/**
+ * @brief Runs every combination of @p dimensions, each in a fresh process, and writes the scaling table.
+ * @param[in] executable The benchmark executable, normally argv[0]
+ * @param[in] arguments The arguments passed to every run, in addition to the swept flags
+ * @param[in] dimensions The swept parameters
+ * @param[in] tablePath Where to write the table; the standard output if empty
+ * @return The process exit code: 0 if every run succeeded
+ */
+int RunSweep( const std::string& executable, const std::vector<std::string>& arguments, const std::vector<SweepDimension>& dimensions, const std::string& tablePath )
+{
+  std::vector<SweepResult> results;
+  std::vector<int> values( dimensions.size() );
+  for( size_t i = 0; i < dimensions.size(); ++i )
+  {
+    values[i] = dimensions[i].mFrom;
+  }
+
+  int exitCode = EXIT_SUCCESS;
+  bool done = dimensions.empty();
+  while( !done )
+  {
+    std::vector<std::string> runArguments( arguments );
+    std::stringstream description;
+    for( size_t i = 0; i < dimensions.size(); ++i )
+    {
+      std::stringstream flag;
+      flag << dimensions[i].mFlag << values[i];
+      runArguments.push_back( flag.str() );
+      description << " " << dimensions[i].mName << "=" << values[i];
+    }
+
+    std::cerr << "Sweep:" << description.str() << std::endl;
+
+    SweepResult result;
+    result.mValues = values;
+    result.mMaxRss = 0;
+    if( !RunSweepConfiguration( executable, runArguments, result ) )
+    {
+      std::cerr << "Sweep: run failed for" << description.str() << std::endl;
+      exitCode = EXIT_FAILURE;
+    }
+    results.push_back( result );
+
+    // Advance to the next combination, last dimension fastest.
+    done = true;
+    for( size_t i = dimensions.size(); i-- > 0; )
+    {
+      values[i] += dimensions[i].mStep;
+      if( values[i] <= dimensions[i].mTo )
+      {
+        done = false;
+        break;
+      }
+      values[i] = dimensions[i].mFrom;
+    }
+  }
+
+  if( tablePath.empty() )
+  {
+    WriteSweepTable( std::cout, dimensions, results );
+  }
+  else
+  {
+    std::ofstream table( tablePath.c_str() );
+    WriteSweepTable( table, dimensions, results );
+    if( !table.good() )
+    {
+      std::cerr << "Unable to write sweep table to " << tablePath << std::endl;
+      exitCode = EXIT_FAILURE;
+    }
+  }
+
+  return exitCode;
+}
+
+} // DemoHelper
+
+#endif // DALI_DEMO_BENCHMARK_SWEEP_H
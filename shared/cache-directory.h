@@ -0,0 +1,60 @@
+#ifndef DALI_DEMO_CACHE_DIRECTORY_H
+#define DALI_DEMO_CACHE_DIRECTORY_H
+
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstdlib>
+#include <string>
+#include <sys/stat.h>
+
+namespace DemoHelper
+{
+
+/**
+ * @brief Returns the directory the demos cache files in, $XDG_CACHE_HOME/dali-demo
+ * (or ~/.cache/dali-demo), creating it if needed.
+ *
+ * @return The directory, or an empty string if there is no home directory.
+ */
+std::string GetCacheDirectory()
+{
+  std::string directory;
+  const char* cacheHome = getenv( "XDG_CACHE_HOME" );
+  if( cacheHome && *cacheHome )
+  {
+    directory = cacheHome;
+  }
+  else
+  {
+    const char* home = getenv( "HOME" );
+    if( !home || !*home )
+    {
+      return std::string();
+    }
+    directory = std::string( home ) + "/.cache";
+  }
+
+  mkdir( directory.c_str(), 0700 );
+  directory += "/dali-demo";
+  mkdir( directory.c_str(), 0700 );
+  return directory;
+}
+
+} // DemoHelper
+
+#endif // DALI_DEMO_CACHE_DIRECTORY_H
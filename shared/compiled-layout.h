@@ -0,0 +1,71 @@
+#ifndef DALI_DEMO_COMPILED_LAYOUT_H
+#define DALI_DEMO_COMPILED_LAYOUT_H
+
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <sys/stat.h>
+
+namespace DemoHelper
+{
+
+/**
+ * @brief Returns where dali-layout-compiler's output for a layout is installed, in a "compiled"
+ * directory next to it, e.g. scripts/compiled/clock.json for scripts/clock.json.
+ */
+std::string GetCompiledLayoutPath( const std::string& path )
+{
+  const size_t slash = path.rfind( '/' );
+  if( slash == std::string::npos )
+  {
+    return "compiled/" + path;
+  }
+  return path.substr( 0, slash + 1 ) + "compiled" + path.substr( slash );
+}
+
+/**
+ * @brief Reads a Builder layout for Builder::LoadFromString().
+ *
+ * The compiled layout, without comments and with the build time constants already substituted,
+ * is read instead of the JSON unless the JSON has been changed since it was compiled.
+ */
+std::string ReadLayout( const std::string& path )
+{
+  std::string readPath( path );
+
+  const std::string compiledPath = GetCompiledLayoutPath( path );
+  struct stat compiled;
+  struct stat source;
+  if( stat( compiledPath.c_str(), &compiled ) == 0 && S_ISREG( compiled.st_mode ) &&
+      ( stat( path.c_str(), &source ) != 0 ||
+        compiled.st_mtim.tv_sec > source.st_mtim.tv_sec ||
+        ( compiled.st_mtim.tv_sec == source.st_mtim.tv_sec && compiled.st_mtim.tv_nsec >= source.st_mtim.tv_nsec ) ) )
+  {
+    readPath = compiledPath;
+  }
+
+  std::ifstream file( readPath.c_str() );
+  return std::string( ( std::istreambuf_iterator<char>( file ) ), std::istreambuf_iterator<char>() );
+}
+
+} // namespace DemoHelper
+
+#endif // DALI_DEMO_COMPILED_LAYOUT_H
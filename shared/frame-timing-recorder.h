@@ -0,0 +1,503 @@
+#ifndef DALI_DEMO_FRAME_TIMING_RECORDER_H
+#define DALI_DEMO_FRAME_TIMING_RECORDER_H
+
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <dali/dali.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <time.h>
+
+// INTERNAL INCLUDES
+#include "shared/memory-usage.h"
+
+namespace DemoHelper
+{
+
+/**
+ * @brief Records the duration of every frame produced while a benchmark is running.
+ *
+ * A hidden actor is added to the stage with a constraint that is re-applied by the
+ * update thread once per frame; the constraint stamps the monotonic clock so the
+ * difference between consecutive stamps is the frame duration. Frames are tagged with
+ * the phase (e.g. "show", "scroll", "hide") that was current when they were produced.
+ *
+ * The phase is passed to the update thread as a property, so phase changes are ordered
+ * with the rest of the event-thread messages. The samples are read back once the main
+ * loop has finished, when the update thread is no longer running.
+ *
+ * The memory usage of the process can also be sampled at phase boundaries with
+ * SampleMemory(); the samples, the peak RSS and the memory cost per actor are
+ * included in the report.
+ */
+class FrameTimingRecorder
+{
+public:
+
+  /**
+   * @brief Summary statistics for a single phase, all durations in milliseconds.
+   */
+  struct PhaseStatistics
+  {
+    PhaseStatistics()
+    : mFrameCount( 0u ),
+      mMean( 0.0 ),
+      mP50( 0.0 ),
+      mP95( 0.0 ),
+      mP99( 0.0 ),
+      mMax( 0.0 ),
+      mDroppedFrames( 0u )
+    {
+    }
+
+    std::string  mName;          ///< The name of the phase
+    unsigned int mFrameCount;    ///< Number of frames measured in the phase
+    double       mMean;          ///< Mean frame duration
+    double       mP50;           ///< Median frame duration
+    double       mP95;           ///< 95th percentile frame duration
+    double       mP99;           ///< 99th percentile frame duration
+    double       mMax;           ///< Longest frame
+    unsigned int mDroppedFrames; ///< Number of vsync intervals missed
+  };
+
+  /**
+   * @brief Constructor.
+   * @param[in] targetFrameInterval The expected frame interval in milliseconds, used to count dropped frames.
+   */
+  FrameTimingRecorder( double targetFrameInterval = 1000.0 / 60.0 )
+  : mStorage( new Storage ),
+    mTargetFrameInterval( targetFrameInterval ),
+    mPhaseIndex( Dali::Property::INVALID_INDEX ),
+    mPeakRss( 0u ),
+    mBytesPerActor( 0.0 )
+  {
+    mStorage->mSamples.reserve( INITIAL_SAMPLE_CAPACITY );
+  }
+
+  ~FrameTimingRecorder()
+  {
+    Stop();
+    delete mStorage;
+  }
+
+  /**
+   * @brief Adds a parameter describing the scenario, written at the top of the report.
+   */
+  void AddParameter( const std::string& name, const std::string& value )
+  {
+    mParameters.push_back( Parameter( name, "\"" + value + "\"", value ) );
+  }
+
+  /**
+   * @copydoc AddParameter()
+   */
+  void AddParameter( const std::string& name, unsigned int value )
+  {
+    std::ostringstream stream;
+    stream << value;
+    mParameters.push_back( Parameter( name, stream.str(), stream.str() ) );
+  }
+
+  /**
+   * @brief Starts recording; frames are attributed to @p phase until SetPhase() is called.
+   * @param[in] phase The name of the first phase.
+   */
+  void Start( const std::string& phase )
+  {
+    if( mActor )
+    {
+      return;
+    }
+
+    mActor = Dali::Actor::New();
+    mActor.SetName( "FrameTimingRecorder" );
+    mPhaseIndex = mActor.RegisterProperty( "frameTimingPhase", static_cast<int>( PhaseId( phase ) ) );
+    Dali::Property::Index tickIndex = mActor.RegisterProperty( "frameTimingTick", 0.0f );
+    Dali::Stage::GetCurrent().Add( mActor );
+
+    mConstraint = Dali::Constraint::New<float>( mActor, tickIndex, TickConstraint( mStorage ) );
+    mConstraint.AddSource( Dali::LocalSource( mPhaseIndex ) );
+    mConstraint.Apply();
+  }
+
+  /**
+   * @brief Attributes the following frames to @p phase.
+   */
+  void SetPhase( const std::string& phase )
+  {
+    if( mActor )
+    {
+      mActor.SetProperty( mPhaseIndex, static_cast<int>( PhaseId( phase ) ) );
+    }
+  }
+
+  /**
+   * @brief Records the memory usage of the process under @p name, e.g. "after show".
+   */
+  void SampleMemory( const std::string& name )
+  {
+    MemoryUsage usage = ReadMemoryUsage();
+    mPeakRss = std::max( mPeakRss, usage.mPeakRss );
+    mMemorySamples.push_back( std::make_pair( name, usage ) );
+  }
+
+  /**
+   * @brief Records the memory usage under @p name, once @p actorCount actors have been created since the previous sample.
+   *
+   * The growth of the RSS since the previous sample, divided by @p actorCount, is reported as the memory cost per actor.
+   */
+  void SampleMemory( const std::string& name, unsigned int actorCount )
+  {
+    const unsigned long previousRss = mMemorySamples.empty() ? 0u : mMemorySamples.back().second.mRss;
+    SampleMemory( name );
+    const unsigned long rss = mMemorySamples.back().second.mRss;
+    if( actorCount > 0u && rss > previousRss )
+    {
+      mBytesPerActor = ( rss - previousRss ) * 1024.0 / actorCount;
+    }
+  }
+
+  /**
+   * @brief Stops recording. Samples are kept for the report.
+   */
+  void Stop()
+  {
+    if( mActor )
+    {
+      mPeakRss = std::max( mPeakRss, ReadMemoryUsage().mPeakRss );
+    }
+
+    if( mConstraint )
+    {
+      mConstraint.Remove();
+      mConstraint.Reset();
+    }
+    if( mActor )
+    {
+      mActor.Unparent();
+      mActor.Reset();
+    }
+  }
+
+  /**
+   * @brief Computes the statistics of every phase, in the order the phases were first used.
+   *
+   * Must only be called once the main loop has stopped or after Stop().
+   */
+  std::vector<PhaseStatistics> GetStatistics() const
+  {
+    std::vector< std::vector<double> > durations = GetFrameDurations();
+
+    std::vector<PhaseStatistics> statistics( mPhaseNames.size() );
+    for( size_t i = 0; i < durations.size(); ++i )
+    {
+      PhaseStatistics& phase = statistics[i];
+      phase.mName = mPhaseNames[i];
+
+      std::vector<double>& frames = durations[i];
+      if( frames.empty() )
+      {
+        continue;
+      }
+      std::sort( frames.begin(), frames.end() );
+
+      double total = 0.0;
+      for( size_t j = 0; j < frames.size(); ++j )
+      {
+        total += frames[j];
+        int intervals = static_cast<int>( frames[j] / mTargetFrameInterval + 0.5 );
+        if( intervals > 1 )
+        {
+          phase.mDroppedFrames += intervals - 1;
+        }
+      }
+
+      phase.mFrameCount = frames.size();
+      phase.mMean = total / frames.size();
+      phase.mP50 = Percentile( frames, 0.50 );
+      phase.mP95 = Percentile( frames, 0.95 );
+      phase.mP99 = Percentile( frames, 0.99 );
+      phase.mMax = frames.back();
+    }
+
+    return statistics;
+  }
+
+  /**
+   * @brief Writes the report to @p path, as CSV if the file name ends in ".csv" and JSON otherwise.
+   *
+   * If @p path is empty the JSON report is written to the standard output.
+   * @return true if the report was written.
+   */
+  bool WriteReport( const std::string& path ) const
+  {
+    const bool csv = path.size() >= 4u && path.compare( path.size() - 4u, 4u, ".csv" ) == 0;
+
+    if( path.empty() )
+    {
+      WriteJson( std::cout );
+      return true;
+    }
+
+    std::ofstream file( path.c_str() );
+    if( !file )
+    {
+      std::cerr << "Unable to write frame timing report to " << path << std::endl;
+      return false;
+    }
+
+    if( csv )
+    {
+      WriteCsv( file );
+    }
+    else
+    {
+      WriteJson( file );
+    }
+    return file.good();
+  }
+
+  /**
+   * @brief Writes the duration of every frame to @p path, as CSV lines of "phase,frame_ms" in the order they were produced.
+   *
+   * Used to compare the distribution of frame times between runs.
+   * @return true if the file was written.
+   */
+  bool WriteFrameTimes( const std::string& path ) const
+  {
+    std::ofstream file( path.c_str() );
+    if( !file )
+    {
+      std::cerr << "Unable to write frame times to " << path << std::endl;
+      return false;
+    }
+
+    file << "phase,frame_ms\n";
+    const std::vector<Sample>& samples = mStorage->mSamples;
+    for( size_t i = 1; i < samples.size(); ++i )
+    {
+      if( samples[i].mPhase < mPhaseNames.size() )
+      {
+        file << mPhaseNames[ samples[i].mPhase ] << "," << FrameDuration( i ) << "\n";
+      }
+    }
+    file.flush();
+    return file.good();
+  }
+
+  /**
+   * @brief Writes the report in JSON format.
+   */
+  void WriteJson( std::ostream& stream ) const
+  {
+    std::vector<PhaseStatistics> statistics = GetStatistics();
+
+    stream << "{\n  \"parameters\": {";
+    for( size_t i = 0; i < mParameters.size(); ++i )
+    {
+      stream << ( i ? "," : "" ) << "\n    \"" << mParameters[i].mName << "\": " << mParameters[i].mJsonValue;
+    }
+    stream << "\n  },\n  \"targetFrameInterval\": " << mTargetFrameInterval << ",\n  \"phases\": [";
+    for( size_t i = 0; i < statistics.size(); ++i )
+    {
+      const PhaseStatistics& phase = statistics[i];
+      stream << ( i ? "," : "" ) << "\n    {"
+             << " \"name\": \"" << phase.mName << "\","
+             << " \"frames\": " << phase.mFrameCount << ","
+             << " \"mean\": " << phase.mMean << ","
+             << " \"p50\": " << phase.mP50 << ","
+             << " \"p95\": " << phase.mP95 << ","
+             << " \"p99\": " << phase.mP99 << ","
+             << " \"max\": " << phase.mMax << ","
+             << " \"dropped\": " << phase.mDroppedFrames << " }";
+    }
+    stream << "\n  ],\n  \"memory\": {\n    \"peakRssKb\": " << mPeakRss << ",\n    \"bytesPerActor\": " << mBytesPerActor << ",\n    \"samples\": [";
+    for( size_t i = 0; i < mMemorySamples.size(); ++i )
+    {
+      const MemoryUsage& usage = mMemorySamples[i].second;
+      stream << ( i ? "," : "" ) << "\n      {"
+             << " \"name\": \"" << mMemorySamples[i].first << "\","
+             << " \"rssKb\": " << usage.mRss << ","
+             << " \"pssKb\": " << usage.mPss << ","
+             << " \"graphicsKb\": " << usage.mGraphics << " }";
+    }
+    stream << "\n    ]\n  }\n}" << std::endl;
+  }
+
+  /**
+   * @brief Writes the report in CSV format; parameters and memory usage are written as leading comment lines.
+   */
+  void WriteCsv( std::ostream& stream ) const
+  {
+    std::vector<PhaseStatistics> statistics = GetStatistics();
+
+    for( size_t i = 0; i < mParameters.size(); ++i )
+    {
+      stream << "# " << mParameters[i].mName << "=" << mParameters[i].mTextValue << "\n";
+    }
+    stream << "# peak_rss_kb=" << mPeakRss << "\n";
+    stream << "# bytes_per_actor=" << mBytesPerActor << "\n";
+    for( size_t i = 0; i < mMemorySamples.size(); ++i )
+    {
+      const MemoryUsage& usage = mMemorySamples[i].second;
+      stream << "# memory_" << mMemorySamples[i].first << "=rss_kb:" << usage.mRss << ";pss_kb:" << usage.mPss << ";graphics_kb:" << usage.mGraphics << "\n";
+    }
+    stream << "phase,frames,mean_ms,p50_ms,p95_ms,p99_ms,max_ms,dropped\n";
+    for( size_t i = 0; i < statistics.size(); ++i )
+    {
+      const PhaseStatistics& phase = statistics[i];
+      stream << phase.mName << ","
+             << phase.mFrameCount << ","
+             << phase.mMean << ","
+             << phase.mP50 << ","
+             << phase.mP95 << ","
+             << phase.mP99 << ","
+             << phase.mMax << ","
+             << phase.mDroppedFrames << "\n";
+    }
+    stream.flush();
+  }
+
+private:
+
+  static const size_t INITIAL_SAMPLE_CAPACITY = 16384u; ///< Avoids reallocating on the update thread for runs of a few minutes
+
+  struct Sample
+  {
+    unsigned int       mPhase;
+    unsigned long long mTimestamp; ///< Monotonic clock in nanoseconds
+  };
+
+  struct Storage
+  {
+    std::vector<Sample> mSamples;
+  };
+
+  struct Parameter
+  {
+    Parameter( const std::string& name, const std::string& jsonValue, const std::string& textValue )
+    : mName( name ),
+      mJsonValue( jsonValue ),
+      mTextValue( textValue )
+    {
+    }
+
+    std::string mName;
+    std::string mJsonValue;
+    std::string mTextValue;
+  };
+
+  /**
+   * @brief Constraint functor, called by the update thread once per frame.
+   */
+  struct TickConstraint
+  {
+    TickConstraint( Storage* storage )
+    : mStorage( storage )
+    {
+    }
+
+    void operator()( float& current, const Dali::PropertyInputContainer& inputs )
+    {
+      timespec time;
+      clock_gettime( CLOCK_MONOTONIC, &time );
+
+      Sample sample;
+      sample.mPhase = static_cast<unsigned int>( inputs[0]->GetInteger() );
+      sample.mTimestamp = static_cast<unsigned long long>( time.tv_sec ) * 1000000000ull + time.tv_nsec;
+      mStorage->mSamples.push_back( sample );
+
+      current += 1.0f;
+    }
+
+    Storage* mStorage;
+  };
+
+  /**
+   * @brief The duration in milliseconds of the frame ending with sample @p index, which must be greater than 0.
+   */
+  double FrameDuration( size_t index ) const
+  {
+    const std::vector<Sample>& samples = mStorage->mSamples;
+    return static_cast<double>( samples[index].mTimestamp - samples[index - 1u].mTimestamp ) * 1.0e-6;
+  }
+
+  /**
+   * @brief The frame durations of each phase, in the order they were produced.
+   */
+  std::vector< std::vector<double> > GetFrameDurations() const
+  {
+    std::vector< std::vector<double> > durations( mPhaseNames.size() );
+    const std::vector<Sample>& samples = mStorage->mSamples;
+    for( size_t i = 1; i < samples.size(); ++i )
+    {
+      if( samples[i].mPhase < durations.size() )
+      {
+        durations[ samples[i].mPhase ].push_back( FrameDuration( i ) );
+      }
+    }
+    return durations;
+  }
+
+  unsigned int PhaseId( const std::string& phase )
+  {
+    std::vector<std::string>::iterator iter = std::find( mPhaseNames.begin(), mPhaseNames.end(), phase );
+    if( iter != mPhaseNames.end() )
+    {
+      return iter - mPhaseNames.begin();
+    }
+    mPhaseNames.push_back( phase );
+    return mPhaseNames.size() - 1u;
+  }
+
+  /**
+   * @brief Nearest-rank percentile of an already sorted, non-empty list.
+   */
+  static double Percentile( const std::vector<double>& sorted, double fraction )
+  {
+    size_t rank = static_cast<size_t>( fraction * sorted.size() + 0.999999 );
+    rank = std::max( rank, size_t( 1u ) );
+    return sorted[ std::min( rank, sorted.size() ) - 1u ];
+  }
+
+  // Not copyable: the constraint refers to the storage.
+  FrameTimingRecorder( const FrameTimingRecorder& );
+  FrameTimingRecorder& operator=( const FrameTimingRecorder& );
+
+private:
+
+  Storage*                 mStorage;
+  double                   mTargetFrameInterval;
+  Dali::Actor              mActor;
+  Dali::Constraint         mConstraint;
+  Dali::Property::Index    mPhaseIndex;
+  std::vector<std::string> mPhaseNames;
+  std::vector<Parameter>   mParameters;
+  std::vector< std::pair<std::string, MemoryUsage> > mMemorySamples;
+  unsigned long            mPeakRss;       ///< In KB
+  double                   mBytesPerActor;
+};
+
+} // DemoHelper
+
+#endif // DALI_DEMO_FRAME_TIMING_RECORDER_H
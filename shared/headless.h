@@ -0,0 +1,191 @@
+#ifndef DALI_DEMO_HEADLESS_H
+#define DALI_DEMO_HEADLESS_H
+
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <dali/dali.h>
+#include <vector>
+
+/**
+ * Helpers for running the benchmarks on machines without a display or GPU.
+ *
+ * The adaptor still needs a window surface to create its GL context, so the
+ * benchmarks are expected to be run under a virtual display with software GL,
+ * e.g.:
+ *
+ *   LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -a benchmark.example --headless
+ */
+namespace DemoHelper
+{
+
+/**
+ * @brief Redirects the default render task into an offscreen frame buffer the size of the stage.
+ *
+ * Everything is still rendered but nothing is presented to the window.
+ */
+void RenderOffscreen()
+{
+  Dali::Stage stage = Dali::Stage::GetCurrent();
+  Dali::Vector2 stageSize = stage.GetSize();
+
+  Dali::FrameBufferImage frameBuffer = Dali::FrameBufferImage::New( stageSize.width, stageSize.height );
+  Dali::RenderTask renderTask = stage.GetRenderTaskList().GetTask( 0u );
+  renderTask.SetTargetFrameBuffer( frameBuffer );
+}
+
+/**
+ * @brief Plays animations against a fixed-step clock rather than the wall clock.
+ *
+ * When enabled, animations passed to Play() are paused and their progress is advanced by
+ * a fixed step once per rendered frame, so each run renders exactly the same sequence of
+ * frames whatever the speed of the machine, and the frame durations measure the rendering
+ * rather than a timer. Once the end is reached the animation is resumed from its final
+ * progress so that its FinishedSignal is emitted as usual.
+ *
+ * Frames are detected with a render task that renders once, into a 1x1 frame buffer, an
+ * empty actor that nothing else renders; it is re-armed after each step, so the next step
+ * waits for the frame showing the last one to have been rendered.
+ *
+ * When disabled, Play() simply plays the animation.
+ */
+class FixedStepClock : public Dali::ConnectionTracker
+{
+public:
+
+  FixedStepClock()
+  : mStep( 0u )
+  {
+  }
+
+  /**
+   * @brief Enables fixed-step playback.
+   * @param[in] step The amount of animation time to advance per frame, in milliseconds.
+   */
+  void Enable( unsigned int step )
+  {
+    mStep = step > 0u ? step : 1u;
+  }
+
+  /**
+   * @brief Whether fixed-step playback is enabled.
+   */
+  bool IsEnabled() const
+  {
+    return mStep > 0u;
+  }
+
+  /**
+   * @brief Plays @p animation, using the fixed-step clock if enabled.
+   */
+  void Play( Dali::Animation animation )
+  {
+    animation.Play();
+    if( !IsEnabled() )
+    {
+      return;
+    }
+
+    animation.Pause();
+    mAnimations.push_back( SteppedAnimation( animation ) );
+    if( mAnimations.size() == 1u )
+    {
+      WaitForFrame();
+    }
+  }
+
+private:
+
+  struct SteppedAnimation
+  {
+    SteppedAnimation( Dali::Animation animation )
+    : mAnimation( animation ),
+      mElapsed( 0.0f )
+    {
+    }
+
+    Dali::Animation mAnimation;
+    float           mElapsed;   ///< Animation time played so far, in seconds
+  };
+
+  /**
+   * @brief Arms the frame task, creating it if there is none, so OnFrame() is called once the next frame has been rendered.
+   */
+  void WaitForFrame()
+  {
+    if( mFrameTask )
+    {
+      mFrameTask.SetRefreshRate( Dali::RenderTask::REFRESH_ONCE );
+      return;
+    }
+
+    Dali::Stage stage = Dali::Stage::GetCurrent();
+    mFrameActor = Dali::Actor::New();
+    mFrameActor.SetSize( 1.0f, 1.0f );
+    stage.Add( mFrameActor );
+
+    mFrameTask = stage.GetRenderTaskList().CreateTask();
+    mFrameTask.SetSourceActor( mFrameActor );
+    mFrameTask.SetExclusive( true );
+    mFrameTask.SetInputEnabled( false );
+    mFrameTask.SetClearEnabled( false );
+    mFrameTask.SetTargetFrameBuffer( Dali::FrameBufferImage::New( 1u, 1u ) );
+    mFrameTask.SetRefreshRate( Dali::RenderTask::REFRESH_ONCE );
+    mFrameTask.FinishedSignal().Connect( this, &FixedStepClock::OnFrame );
+  }
+
+  void OnFrame( Dali::RenderTask& renderTask )
+  {
+    const float step = mStep * 0.001f;
+
+    for( std::vector<SteppedAnimation>::iterator iter = mAnimations.begin(); iter != mAnimations.end(); )
+    {
+      Dali::Animation& animation = iter->mAnimation;
+      const float duration = animation.GetDuration();
+
+      iter->mElapsed += step;
+      if( iter->mElapsed >= duration )
+      {
+        animation.SetCurrentProgress( 1.0f );
+        animation.Play();
+        iter = mAnimations.erase( iter );
+      }
+      else
+      {
+        animation.SetCurrentProgress( iter->mElapsed / duration );
+        ++iter;
+      }
+    }
+
+    if( !mAnimations.empty() )
+    {
+      WaitForFrame();
+    }
+  }
+
+private:
+
+  Dali::Actor                   mFrameActor;
+  Dali::RenderTask              mFrameTask;  ///< Renders once, finishing when the next frame has been rendered
+  std::vector<SteppedAnimation> mAnimations;
+  unsigned int                  mStep;       ///< Milliseconds of animation time per frame, 0 when disabled
+};
+
+} // DemoHelper
+
+#endif // DALI_DEMO_HEADLESS_H
@@ -0,0 +1,152 @@
+#ifndef DALI_DEMO_LAUNCH_TIMING_H
+#define DALI_DEMO_LAUNCH_TIMING_H
+
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <dali/dali.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * Launch latency reporting between dali-demo and the examples it starts.
+ *
+ * When dali-demo starts an example it sets these environment variables:
+ *
+ *   DALI_DEMO_LAUNCH_NAME       The name of the example
+ *   DALI_DEMO_LAUNCH_TIME       When its tile was pressed, from GetLaunchClock()
+ *   DALI_DEMO_LAUNCH_REPORT_FD  A pipe to write the report to
+ *
+ * The example writes a single "name,init_ms,first_frame_ms" line to the pipe, where
+ * init_ms is when the Application was initialised and first_frame_ms when its first
+ * frame was rendered, both in milliseconds since the press.
+ */
+namespace DemoHelper
+{
+
+const char* const LAUNCH_NAME_ENV      = "DALI_DEMO_LAUNCH_NAME";
+const char* const LAUNCH_TIME_ENV      = "DALI_DEMO_LAUNCH_TIME";
+const char* const LAUNCH_REPORT_FD_ENV = "DALI_DEMO_LAUNCH_REPORT_FD";
+
+/**
+ * @brief Monotonic time in microseconds, comparable between processes.
+ */
+unsigned long long GetLaunchClock()
+{
+  timespec time;
+  clock_gettime( CLOCK_MONOTONIC, &time );
+  return static_cast<unsigned long long>( time.tv_sec ) * 1000000ull + time.tv_nsec / 1000;
+}
+
+/**
+ * @brief Reports the launch timing of an example to dali-demo.
+ *
+ * The first frame is detected with a render task that renders once, into a 1x1 frame buffer,
+ * an empty actor that nothing else renders; it finishes in the first frame that is rendered.
+ */
+class LaunchTimingReporter : public Dali::ConnectionTracker
+{
+public:
+
+  LaunchTimingReporter( Dali::Application& application, const std::string& name, unsigned long long launchTime, int reportFd )
+  : mName( name ),
+    mLaunchTime( launchTime ),
+    mInitTime( 0u ),
+    mReportFd( reportFd )
+  {
+    application.InitSignal().Connect( this, &LaunchTimingReporter::OnInit );
+  }
+
+private:
+
+  void OnInit( Dali::Application& application )
+  {
+    mInitTime = GetLaunchClock();
+
+    Dali::Stage stage = Dali::Stage::GetCurrent();
+    mSourceActor = Dali::Actor::New();
+    mSourceActor.SetSize( 1.0f, 1.0f );
+    stage.Add( mSourceActor );
+
+    mRenderTask = stage.GetRenderTaskList().CreateTask();
+    mRenderTask.SetSourceActor( mSourceActor );
+    mRenderTask.SetExclusive( true );
+    mRenderTask.SetInputEnabled( false );
+    mRenderTask.SetClearEnabled( false );
+    mRenderTask.SetTargetFrameBuffer( Dali::FrameBufferImage::New( 1u, 1u ) );
+    mRenderTask.SetRefreshRate( Dali::RenderTask::REFRESH_ONCE );
+    mRenderTask.FinishedSignal().Connect( this, &LaunchTimingReporter::OnFirstFrame );
+  }
+
+  void OnFirstFrame( Dali::RenderTask& renderTask )
+  {
+    const unsigned long long firstFrameTime = GetLaunchClock();
+
+    char report[256];
+    int length = snprintf( report, sizeof( report ), "%s,%.1f,%.1f\n", mName.c_str(),
+                           ( mInitTime - mLaunchTime ) * 0.001, ( firstFrameTime - mLaunchTime ) * 0.001 );
+    if( length > 0 && static_cast<size_t>( length ) < sizeof( report ) && write( mReportFd, report, length ) != length )
+    {
+      fprintf( stderr, "Unable to report the launch timing of %s\n", mName.c_str() );
+    }
+    close( mReportFd );
+
+    Dali::Stage::GetCurrent().GetRenderTaskList().RemoveTask( mRenderTask );
+    mRenderTask.Reset();
+    mSourceActor.Unparent();
+    mSourceActor.Reset();
+  }
+
+private:
+
+  Dali::Actor        mSourceActor;
+  Dali::RenderTask   mRenderTask;
+  std::string        mName;
+  unsigned long long mLaunchTime; ///< From GetLaunchClock()
+  unsigned long long mInitTime;   ///< From GetLaunchClock()
+  int                mReportFd;
+};
+
+/**
+ * @brief Reports the launch timing of the example to dali-demo, if it was started from dali-demo.
+ *
+ * Should be called straight after the Application is created. The environment variables
+ * are cleared so that processes the example starts do not report as well.
+ */
+void ReportLaunchTiming( Dali::Application& application )
+{
+  const char* name = getenv( LAUNCH_NAME_ENV );
+  const char* launchTime = getenv( LAUNCH_TIME_ENV );
+  const char* reportFd = getenv( LAUNCH_REPORT_FD_ENV );
+  if( name && launchTime && reportFd )
+  {
+    // Never destroyed, it must outlive the signals it is connected to.
+    new LaunchTimingReporter( application, name, strtoull( launchTime, NULL, 10 ), atoi( reportFd ) );
+  }
+
+  unsetenv( LAUNCH_NAME_ENV );
+  unsetenv( LAUNCH_TIME_ENV );
+  unsetenv( LAUNCH_REPORT_FD_ENV );
+}
+
+} // DemoHelper
+
+#endif // DALI_DEMO_LAUNCH_TIMING_H
@@ -0,0 +1,120 @@
+#ifndef DALI_DEMO_MEMORY_USAGE_H
+#define DALI_DEMO_MEMORY_USAGE_H
+
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace DemoHelper
+{
+
+/**
+ * @brief Memory used by the process, all sizes in KB.
+ */
+struct MemoryUsage
+{
+  MemoryUsage()
+  : mRss( 0u ),
+    mPeakRss( 0u ),
+    mPss( 0u ),
+    mGraphics( 0u )
+  {
+  }
+
+  unsigned long mRss;      ///< Resident set size
+  unsigned long mPeakRss;  ///< Highest resident set size so far, as tracked by the kernel
+  unsigned long mPss;      ///< Proportional set size: shared pages are divided between the processes sharing them
+  unsigned long mGraphics; ///< Resident memory mapped from the graphics driver, where textures and buffers live
+};
+
+/**
+ * @brief Whether a mapping in /proc/self/smaps is graphics memory mapped from the GPU driver.
+ *
+ * With software GL the textures are on the heap and this is 0; they are then part of mRss.
+ */
+bool IsGraphicsMapping( const std::string& path )
+{
+  return path.compare( 0, 9, "/dev/dri/" ) == 0 ||
+         path.compare( 0, 9, "/dev/mali" ) == 0 ||
+         path.compare( 0, 9, "/dev/kgsl" ) == 0 ||
+         path.compare( 0, 11, "/dev/nvidia" ) == 0 ||
+         path.compare( 0, 10, "/dev/pvrsr" ) == 0;
+}
+
+/**
+ * @brief Reads the current memory usage of the process from /proc.
+ */
+MemoryUsage ReadMemoryUsage()
+{
+  MemoryUsage usage;
+
+  std::ifstream status( "/proc/self/status" );
+  std::string line;
+  while( std::getline( status, line ) )
+  {
+    if( line.compare( 0, 6, "VmRSS:" ) == 0 )
+    {
+      usage.mRss = strtoul( line.c_str() + 6, NULL, 10 );
+    }
+    else if( line.compare( 0, 6, "VmHWM:" ) == 0 )
+    {
+      usage.mPeakRss = strtoul( line.c_str() + 6, NULL, 10 );
+    }
+  }
+
+  // Each mapping starts with a header line "address perms offset dev inode [path]",
+  // followed by "Name: value kB" lines.
+  std::ifstream smaps( "/proc/self/smaps" );
+  bool graphicsMapping = false;
+  while( std::getline( smaps, line ) )
+  {
+    if( line.compare( 0, 4, "Pss:" ) == 0 )
+    {
+      usage.mPss += strtoul( line.c_str() + 4, NULL, 10 );
+    }
+    else if( line.compare( 0, 4, "Rss:" ) == 0 )
+    {
+      if( graphicsMapping )
+      {
+        usage.mGraphics += strtoul( line.c_str() + 4, NULL, 10 );
+      }
+    }
+    else if( !line.empty() && line.find( ':' ) > line.find( ' ' ) )
+    {
+      // A mapping header: its first field is an address range, not a "Name:" key
+      std::istringstream header( line );
+      std::string field;
+      std::string path;
+      for( int i = 0; i < 6 && header >> field; ++i )
+      {
+        path = i == 5 ? field : path;
+      }
+      graphicsMapping = IsGraphicsMapping( path );
+    }
+  }
+
+  return usage;
+}
+
+} // DemoHelper
+
+#endif // DALI_DEMO_MEMORY_USAGE_H
@@ -0,0 +1,492 @@
+#ifndef DALI_DEMO_SHAPE_DISTANCE_FIELD_H
+#define DALI_DEMO_SHAPE_DISTANCE_FIELD_H
+
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <pthread.h>
+#include <unistd.h>
+
+/**
+ * Rasterizes simple shapes and generates their distance fields for the distance field shader.
+ *
+ * The distance field is exact: the Euclidean distance transform is computed with the
+ * separable linear-time algorithm of Felzenszwalb and Huttenlocher, a pass along the rows
+ * then a pass along the columns. Each pass, like the rasterization and the final
+ * quantization, is split into bands of rows (or columns) run on a thread per core. The
+ * per-row kernels are kept to straight loops over contiguous memory so the compiler can
+ * vectorize them on any target.
+ */
+namespace DemoHelper
+{
+
+namespace Shape
+{
+enum Type
+{
+  CIRCLE,       ///< A disc filling the image
+  RING,         ///< A disc with a hole in the middle
+  ROUNDED_RECT, ///< A square filling the image with corners rounded by a quarter of its size
+  STAR          ///< A five pointed star filling the image
+};
+} // namespace Shape
+
+/**
+ * @brief A function run on a band of rows, [begin, end), by RunRowsInParallel().
+ */
+class RowTask
+{
+public:
+  virtual ~RowTask() {}
+  virtual void Run( unsigned int begin, unsigned int end ) = 0;
+};
+
+struct RowBand
+{
+  RowTask*     mTask;
+  unsigned int mBegin;
+  unsigned int mEnd;
+};
+
+void* RunRowBand( void* data )
+{
+  RowBand* band = static_cast<RowBand*>( data );
+  band->mTask->Run( band->mBegin, band->mEnd );
+  return NULL;
+}
+
+/**
+ * @brief Runs @p task over @p rows rows, split into a band per core.
+ *
+ * The calling thread runs the last band; the call returns once every band is done.
+ */
+void RunRowsInParallel( RowTask& task, unsigned int rows )
+{
+  static const unsigned int MINIMUM_ROWS_PER_BAND = 32u;
+
+  long cores = sysconf( _SC_NPROCESSORS_ONLN );
+  unsigned int bandCount = std::max( 1u, std::min( static_cast<unsigned int>( cores > 0 ? cores : 1 ), rows / MINIMUM_ROWS_PER_BAND ) );
+
+  std::vector<RowBand> bands( bandCount );
+  std::vector<pthread_t> threads( bandCount );
+  std::vector<bool> started( bandCount, false );
+  for( unsigned int i = 0; i < bandCount; ++i )
+  {
+    bands[i].mTask = &task;
+    bands[i].mBegin = rows * i / bandCount;
+    bands[i].mEnd = rows * ( i + 1 ) / bandCount;
+  }
+
+  for( unsigned int i = 0; i + 1 < bandCount; ++i )
+  {
+    started[i] = pthread_create( &threads[i], NULL, &RunRowBand, &bands[i] ) == 0;
+    if( !started[i] )
+    {
+      RunRowBand( &bands[i] );
+    }
+  }
+
+  RunRowBand( &bands[ bandCount - 1 ] );
+
+  for( unsigned int i = 0; i + 1 < bandCount; ++i )
+  {
+    if( started[i] )
+    {
+      pthread_join( threads[i], NULL );
+    }
+  }
+}
+
+/**
+ * @brief Fills the pixels [begin, end) of a row, clipped to the row.
+ */
+void FillSpan( unsigned char* row, unsigned int width, float begin, float end )
+{
+  const int first = std::max( 0, static_cast<int>( std::ceil( begin ) ) );
+  const int last = std::min( static_cast<int>( width ) - 1, static_cast<int>( std::floor( end ) ) );
+  if( first <= last )
+  {
+    memset( row + first, 0xFF, last - first + 1 );
+  }
+}
+
+/**
+ * @brief Rasterizes a shape into a mask, a span per row: 0xFF inside and 0x00 outside.
+ */
+class RasterizeShapeTask : public RowTask
+{
+public:
+
+  RasterizeShapeTask( Shape::Type shape, unsigned int size, unsigned char* mask )
+  : mShape( shape ),
+    mSize( size ),
+    mMask( mask )
+  {
+    // Star outline, alternating outer and inner points, starting at the top.
+    const float outerRadius = size * 0.5f;
+    const float innerRadius = outerRadius * 0.4f;
+    for( unsigned int i = 0; i < STAR_POINTS * 2; ++i )
+    {
+      const float radius = ( i % 2 ) ? innerRadius : outerRadius;
+      const float angle = static_cast<float>( M_PI ) * i / STAR_POINTS;
+      mStarX[i] = size * 0.5f + radius * std::sin( angle );
+      mStarY[i] = size * 0.5f - radius * std::cos( angle );
+    }
+  }
+
+  virtual void Run( unsigned int begin, unsigned int end )
+  {
+    const float center = mSize / 2;
+    const float radius = mSize * 0.5f;
+
+    for( unsigned int y = begin; y < end; ++y )
+    {
+      unsigned char* row = mMask + y * mSize;
+      memset( row, 0, mSize );
+
+      const float dy = y - center;
+      switch( mShape )
+      {
+        case Shape::CIRCLE:
+        {
+          if( dy * dy <= radius * radius )
+          {
+            const float halfWidth = std::sqrt( radius * radius - dy * dy );
+            FillSpan( row, mSize, center - halfWidth, center + halfWidth );
+          }
+          break;
+        }
+        case Shape::RING:
+        {
+          // The hole is where the squared distance is within 70% of the squared radius
+          const float innerSquared = radius * radius * 0.7f;
+          if( dy * dy <= radius * radius )
+          {
+            const float halfWidth = std::sqrt( radius * radius - dy * dy );
+            if( dy * dy <= innerSquared )
+            {
+              const float innerHalfWidth = std::sqrt( innerSquared - dy * dy );
+              FillSpan( row, mSize, center - halfWidth, center - innerHalfWidth - 0.001f );
+              FillSpan( row, mSize, center + innerHalfWidth + 0.001f, center + halfWidth );
+            }
+            else
+            {
+              FillSpan( row, mSize, center - halfWidth, center + halfWidth );
+            }
+          }
+          break;
+        }
+        case Shape::ROUNDED_RECT:
+        {
+          const float cornerRadius = mSize * 0.25f;
+          const float straight = radius - cornerRadius;
+          const float distance = std::fabs( dy );
+          if( distance <= straight )
+          {
+            FillSpan( row, mSize, center - radius, center + radius );
+          }
+          else if( distance <= radius )
+          {
+            const float cornerDy = distance - straight;
+            const float halfWidth = straight + std::sqrt( cornerRadius * cornerRadius - cornerDy * cornerDy );
+            FillSpan( row, mSize, center - halfWidth, center + halfWidth );
+          }
+          break;
+        }
+        case Shape::STAR:
+        {
+          // Even-odd scanline fill of the outline at the pixel centre
+          float crossings[ STAR_POINTS * 2 ];
+          unsigned int count = 0u;
+          const float scanY = y + 0.5f;
+          for( unsigned int i = 0; i < STAR_POINTS * 2; ++i )
+          {
+            const unsigned int j = ( i + 1 ) % ( STAR_POINTS * 2 );
+            if( ( mStarY[i] <= scanY ) != ( mStarY[j] <= scanY ) )
+            {
+              crossings[ count++ ] = mStarX[i] + ( scanY - mStarY[i] ) * ( mStarX[j] - mStarX[i] ) / ( mStarY[j] - mStarY[i] );
+            }
+          }
+          for( unsigned int i = 1; i < count; ++i )
+          {
+            for( unsigned int k = i; k > 0 && crossings[k - 1] > crossings[k]; --k )
+            {
+              std::swap( crossings[k - 1], crossings[k] );
+            }
+          }
+          for( unsigned int i = 0; i + 1 < count; i += 2 )
+          {
+            FillSpan( row, mSize, crossings[i] - 0.5f, crossings[i + 1] - 0.5f );
+          }
+          break;
+        }
+      }
+    }
+  }
+
+private:
+
+  static const unsigned int STAR_POINTS = 5u;
+
+  Shape::Type    mShape;
+  unsigned int   mSize;
+  unsigned char* mMask;
+  float          mStarX[ STAR_POINTS * 2 ];
+  float          mStarY[ STAR_POINTS * 2 ];
+};
+
+/**
+ * @brief One dimensional squared Euclidean distance transform of a sampled function.
+ *
+ * Felzenszwalb and Huttenlocher's lower envelope of parabolas, linear in @p n.
+ *
+ * @param[in] f The function, n samples
+ * @param[out] d The transform, n samples
+ * @param[in] v Scratch space for n vertices
+ * @param[in] z Scratch space for n + 1 boundaries
+ */
+void DistanceTransform1D( const float* f, unsigned int n, float* d, int* v, float* z )
+{
+  int k = 0;
+  v[0] = 0;
+  z[0] = -HUGE_VALF;
+  z[1] = HUGE_VALF;
+
+  for( int q = 1; q < static_cast<int>( n ); ++q )
+  {
+    float s = ( ( f[q] + q * q ) - ( f[ v[k] ] + v[k] * v[k] ) ) / ( 2 * q - 2 * v[k] );
+    while( s <= z[k] )
+    {
+      --k;
+      s = ( ( f[q] + q * q ) - ( f[ v[k] ] + v[k] * v[k] ) ) / ( 2 * q - 2 * v[k] );
+    }
+    ++k;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = HUGE_VALF;
+  }
+
+  k = 0;
+  for( int q = 0; q < static_cast<int>( n ); ++q )
+  {
+    while( z[k + 1] < q )
+    {
+      ++k;
+    }
+    const float offset = q - v[k];
+    d[q] = offset * offset + f[ v[k] ];
+  }
+}
+
+/**
+ * @brief Squared distances along each row to the nearest inside pixel and to the nearest outside pixel.
+ */
+class HorizontalDistanceTask : public RowTask
+{
+public:
+
+  HorizontalDistanceTask( const unsigned char* mask, unsigned int width, float* inside, float* outside )
+  : mMask( mask ),
+    mWidth( width ),
+    mInside( inside ),
+    mOutside( outside )
+  {
+  }
+
+  virtual void Run( unsigned int begin, unsigned int end )
+  {
+    // Large enough to never be the nearest, small enough for the arithmetic to stay finite
+    const float FAR_DISTANCE = 1.0e20f;
+
+    std::vector<float> toInside( mWidth );
+    std::vector<float> toOutside( mWidth );
+    std::vector<int> v( mWidth );
+    std::vector<float> z( mWidth + 1 );
+
+    for( unsigned int y = begin; y < end; ++y )
+    {
+      const unsigned char* row = mMask + y * mWidth;
+      for( unsigned int x = 0; x < mWidth; ++x )
+      {
+        toInside[x] = row[x] ? 0.0f : FAR_DISTANCE;
+        toOutside[x] = row[x] ? FAR_DISTANCE : 0.0f;
+      }
+
+      DistanceTransform1D( &toInside[0], mWidth, mInside + y * mWidth, &v[0], &z[0] );
+      DistanceTransform1D( &toOutside[0], mWidth, mOutside + y * mWidth, &v[0], &z[0] );
+    }
+  }
+
+private:
+
+  const unsigned char* mMask;
+  unsigned int         mWidth;
+  float*               mInside;
+  float*               mOutside;
+};
+
+/**
+ * @brief Completes the distance transforms of HorizontalDistanceTask along each column, in place.
+ *
+ * Its "rows" are the columns of the image.
+ */
+class VerticalDistanceTask : public RowTask
+{
+public:
+
+  VerticalDistanceTask( unsigned int width, unsigned int height, float* inside, float* outside )
+  : mWidth( width ),
+    mHeight( height ),
+    mInside( inside ),
+    mOutside( outside )
+  {
+  }
+
+  virtual void Run( unsigned int begin, unsigned int end )
+  {
+    std::vector<float> column( mHeight );
+    std::vector<float> transformed( mHeight );
+    std::vector<int> v( mHeight );
+    std::vector<float> z( mHeight + 1 );
+
+    float* const fields[] = { mInside, mOutside };
+    for( unsigned int x = begin; x < end; ++x )
+    {
+      for( unsigned int field = 0; field < 2; ++field )
+      {
+        float* data = fields[ field ];
+        for( unsigned int y = 0; y < mHeight; ++y )
+        {
+          column[y] = data[ y * mWidth + x ];
+        }
+        DistanceTransform1D( &column[0], mHeight, &transformed[0], &v[0], &z[0] );
+        for( unsigned int y = 0; y < mHeight; ++y )
+        {
+          data[ y * mWidth + x ] = transformed[y];
+        }
+      }
+    }
+  }
+
+private:
+
+  unsigned int mWidth;
+  unsigned int mHeight;
+  float*       mInside;
+  float*       mOutside;
+};
+
+/**
+ * @brief Converts the squared distances into 8 bit signed distances.
+ *
+ * The edge, halfway between the last inside pixel and the first outside one, is 0.5; the
+ * value reaches 1.0 @p spread pixels inside and 0.0 @p spread pixels outside.
+ */
+class QuantizeDistanceTask : public RowTask
+{
+public:
+
+  QuantizeDistanceTask( const float* inside, const float* outside, unsigned int width, float spread, unsigned char* distanceField )
+  : mInside( inside ),
+    mOutside( outside ),
+    mWidth( width ),
+    mScale( 0.5f / spread ),
+    mDistanceField( distanceField )
+  {
+  }
+
+  virtual void Run( unsigned int begin, unsigned int end )
+  {
+    for( unsigned int y = begin; y < end; ++y )
+    {
+      const float* inside = mInside + y * mWidth;
+      const float* outside = mOutside + y * mWidth;
+      unsigned char* out = mDistanceField + y * mWidth;
+      for( unsigned int x = 0; x < mWidth; ++x )
+      {
+        // One of the two distances is zero: inside pixels have no distance to the inside.
+        const float signedDistance = std::sqrt( outside[x] ) - std::sqrt( inside[x] );
+        const float edgeDistance = signedDistance > 0.0f ? signedDistance - 0.5f : signedDistance + 0.5f;
+        const float value = std::min( std::max( 0.5f + edgeDistance * mScale, 0.0f ), 1.0f );
+        out[x] = static_cast<unsigned char>( value * 255.0f + 0.5f );
+      }
+    }
+  }
+
+private:
+
+  const float*   mInside;
+  const float*   mOutside;
+  unsigned int   mWidth;
+  float          mScale;
+  unsigned char* mDistanceField;
+};
+
+/**
+ * @brief Rasterizes a shape filling a square image into an A8 mask.
+ */
+void RasterizeShape( Shape::Type shape, unsigned int size, std::vector<unsigned char>& maskOut )
+{
+  maskOut.resize( size * size );
+  RasterizeShapeTask task( shape, size, &maskOut[0] );
+  RunRowsInParallel( task, size );
+}
+
+/**
+ * @brief Generates the A8 distance field of a mask, where non-zero pixels are inside.
+ *
+ * @param[in] spread The distance, in pixels, over which the field goes from the edge to fully inside or outside.
+ */
+void GenerateDistanceField( const std::vector<unsigned char>& mask, unsigned int width, unsigned int height, float spread, std::vector<unsigned char>& distanceFieldOut )
+{
+  distanceFieldOut.resize( width * height );
+  if( width == 0u || height == 0u )
+  {
+    return;
+  }
+
+  std::vector<float> inside( width * height );
+  std::vector<float> outside( width * height );
+
+  HorizontalDistanceTask horizontal( &mask[0], width, &inside[0], &outside[0] );
+  RunRowsInParallel( horizontal, height );
+
+  VerticalDistanceTask vertical( width, height, &inside[0], &outside[0] );
+  RunRowsInParallel( vertical, width );
+
+  QuantizeDistanceTask quantize( &inside[0], &outside[0], width, spread, &distanceFieldOut[0] );
+  RunRowsInParallel( quantize, height );
+}
+
+/**
+ * @brief Generates the A8 distance field of a shape filling a square image.
+ */
+void GenerateShapeDistanceField( Shape::Type shape, unsigned int size, float spread, std::vector<unsigned char>& distanceFieldOut )
+{
+  std::vector<unsigned char> mask;
+  RasterizeShape( shape, size, mask );
+  GenerateDistanceField( mask, size, size, spread, distanceFieldOut );
+}
+
+} // DemoHelper
+
+#endif // DALI_DEMO_SHAPE_DISTANCE_FIELD_H
@@ -23,6 +23,10 @@
 #include <dali/devel-api/adaptor-framework/bitmap-loader.h>
 #include <dali/public-api/rendering/geometry.h>
 #include <dali/public-api/rendering/texture.h>
+#include <algorithm>
+#include <list>
+#include <map>
+#include <string>
 
 namespace DemoHelper
 {
@@ -50,18 +54,211 @@ Dali::Atlas LoadImage( const char* imagePath,
   return image;
 }
 
+/**
+ * @brief Process-wide cache of the textures loaded by LoadTexture().
+ *
+ * Textures are keyed by the path and the load parameters, so loading the same image twice
+ * decodes and uploads it once. A texture stays cached while any handle to it is held
+ * elsewhere; textures only held by the cache are kept up to the byte budget and released
+ * least recently used first.
+ */
+class TextureCache
+{
+public:
+
+  static const size_t DEFAULT_BUDGET = 32u * 1024u * 1024u; ///< Bytes of unused textures kept
+
+  /**
+   * @brief Returns the cache. It is never destroyed, so no texture handle outlives the adaptor at exit.
+   */
+  static TextureCache& Get()
+  {
+    static TextureCache* cache = new TextureCache;
+    return *cache;
+  }
+
+  /**
+   * @brief Returns the cached texture for the given load parameters, or an empty handle.
+   */
+  Dali::Texture Find( const char* imagePath, Dali::ImageDimensions size, Dali::FittingMode::Type fittingMode, Dali::SamplingMode::Type samplingMode )
+  {
+    EntryMap::iterator iter = mEntries.find( Key( imagePath, size, fittingMode, samplingMode ) );
+    if( iter == mEntries.end() )
+    {
+      return Dali::Texture();
+    }
+
+    // Most recently used at the front
+    mLru.splice( mLru.begin(), mLru, iter->second.mLruPosition );
+    return iter->second.mTexture;
+  }
+
+  /**
+   * @brief Adds a texture loaded with the given parameters to the cache.
+   */
+  void Add( const char* imagePath, Dali::ImageDimensions size, Dali::FittingMode::Type fittingMode, Dali::SamplingMode::Type samplingMode, Dali::Texture texture, size_t bytes )
+  {
+    Key key( imagePath, size, fittingMode, samplingMode );
+    if( mEntries.find( key ) != mEntries.end() )
+    {
+      return;
+    }
+
+    mLru.push_front( key );
+    Entry& entry = mEntries[key];
+    entry.mTexture = texture;
+    entry.mBytes = bytes;
+    entry.mLruPosition = mLru.begin();
+
+    Trim();
+  }
+
+  /**
+   * @brief Sets the number of bytes of textures not used outside the cache that are kept.
+   */
+  void SetBudget( size_t bytes )
+  {
+    mBudget = bytes;
+    Trim();
+  }
+
+  /**
+   * @brief Releases every texture that is not used outside the cache.
+   */
+  void Clear()
+  {
+    size_t budget = mBudget;
+    mBudget = 0u;
+    Trim();
+    mBudget = budget;
+  }
+
+private:
+
+  struct Key
+  {
+    Key( const char* imagePath, Dali::ImageDimensions size, Dali::FittingMode::Type fittingMode, Dali::SamplingMode::Type samplingMode )
+    : mPath( imagePath ),
+      mWidth( size.GetWidth() ),
+      mHeight( size.GetHeight() ),
+      mFittingMode( fittingMode ),
+      mSamplingMode( samplingMode )
+    {
+    }
+
+    bool operator<( const Key& rhs ) const
+    {
+      if( mWidth != rhs.mWidth )
+      {
+        return mWidth < rhs.mWidth;
+      }
+      if( mHeight != rhs.mHeight )
+      {
+        return mHeight < rhs.mHeight;
+      }
+      if( mFittingMode != rhs.mFittingMode )
+      {
+        return mFittingMode < rhs.mFittingMode;
+      }
+      if( mSamplingMode != rhs.mSamplingMode )
+      {
+        return mSamplingMode < rhs.mSamplingMode;
+      }
+      return mPath < rhs.mPath;
+    }
+
+    std::string              mPath;
+    unsigned int             mWidth;
+    unsigned int             mHeight;
+    Dali::FittingMode::Type  mFittingMode;
+    Dali::SamplingMode::Type mSamplingMode;
+  };
+
+  typedef std::list<Key> LruList;
+
+  struct Entry
+  {
+    Dali::Texture     mTexture;
+    size_t            mBytes;
+    LruList::iterator mLruPosition;
+  };
+
+  typedef std::map<Key, Entry> EntryMap;
+
+  TextureCache()
+  : mBudget( DEFAULT_BUDGET )
+  {
+  }
+
+  /**
+   * @brief Releases the least recently used textures that are only held by the cache until they fit in the budget.
+   */
+  void Trim()
+  {
+    size_t unusedBytes = 0u;
+    for( EntryMap::iterator iter = mEntries.begin(); iter != mEntries.end(); ++iter )
+    {
+      if( !IsUsed( iter->second ) )
+      {
+        unusedBytes += iter->second.mBytes;
+      }
+    }
+
+    for( LruList::iterator iter = mLru.end(); unusedBytes > mBudget && iter != mLru.begin(); )
+    {
+      --iter;
+      EntryMap::iterator entry = mEntries.find( *iter );
+      if( !IsUsed( entry->second ) )
+      {
+        unusedBytes -= entry->second.mBytes;
+        mEntries.erase( entry );
+        iter = mLru.erase( iter );
+      }
+    }
+  }
+
+  /**
+   * @brief Whether a texture has handles outside the cache.
+   */
+  static bool IsUsed( Entry& entry )
+  {
+    return entry.mTexture.GetBaseObject().ReferenceCount() > 1;
+  }
+
+  // Undefined
+  TextureCache( const TextureCache& );
+  TextureCache& operator=( const TextureCache& );
+
+private:
+
+  EntryMap mEntries;
+  LruList  mLru;     ///< Keys, most recently used first
+  size_t   mBudget;
+};
+
 Dali::Texture LoadTexture( const char* imagePath,
                            Dali::ImageDimensions size = Dali::ImageDimensions(),
                            Dali::FittingMode::Type fittingMode = Dali::FittingMode::DEFAULT,
                            Dali::SamplingMode::Type samplingMode = Dali::SamplingMode::DEFAULT )
 {
+  TextureCache& cache = TextureCache::Get();
+  Dali::Texture texture = cache.Find( imagePath, size, fittingMode, samplingMode );
+  if( texture )
+  {
+    return texture;
+  }
+
   Dali::PixelData pixelData = LoadPixelData(imagePath, size, fittingMode, samplingMode);
-  Dali::Texture texture  = Dali::Texture::New( Dali::TextureType::TEXTURE_2D,
-                                               pixelData.GetPixelFormat(),
-                                               pixelData.GetWidth(),
-                                               pixelData.GetHeight() );
+  texture  = Dali::Texture::New( Dali::TextureType::TEXTURE_2D,
+                                 pixelData.GetPixelFormat(),
+                                 pixelData.GetWidth(),
+                                 pixelData.GetHeight() );
   texture.Upload( pixelData );
 
+  // Compressed formats report no bytes per pixel; count them as one.
+  const unsigned int bytesPerPixel = std::max( Dali::Pixel::GetBytesPerPixel( pixelData.GetPixelFormat() ), 1u );
+  cache.Add( imagePath, size, fittingMode, samplingMode, texture, pixelData.GetWidth() * pixelData.GetHeight() * bytesPerPixel );
+
   return texture;
 }
 